@@ -0,0 +1,430 @@
+/*
+  ==============================================================================
+
+    AnalysisTap.h
+    Created: 19 Oct 2026 8:26:52pm
+    Author:  Marc Woodbury-Smith
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "DspGraph.h"
+#include "DspArena.h"
+#include "Fifo.h"
+#include "HalfBandDecimator.h"
+
+/*
+ Everything the analyzer can show, captured by the audio thread into one
+ single-producer single-consumer ring:
+ - the input and output, per channel
+ - every band before and after its compressor, averaged over the channels
+ During a block the lanes are staged side by side. endBlock() interleaves
+ them into the ring in one pass, with at most two runs when the ring wraps.
+ The ring holds a whole number of frames of getFrameSize() samples, so a
+ complete frame never wraps and the reader uses it in place.
+ 
+ At high sample rates the lanes are always decimated by half-band stages
+ before they reach the ring, keeping the analysis rate near 48 kHz: the display
+ stops at 20 kHz, so the extra bandwidth would only cost ring space and FFT bins.
+ */
+struct AnalysisTap
+{
+    enum Lane
+    {
+        InputLeft,
+        InputRight,
+        OutputLeft,
+        OutputRight,
+        FirstBandLane,
+        NumLanes = FirstBandLane + 2 * DspGraph::NumBands
+    };
+    
+    static int getBandLane(int band, bool afterCompressor)
+    {
+        jassert(juce::isPositiveAndBelow(band, DspGraph::NumBands));
+        return FirstBandLane + 2 * band + (afterCompressor ? 1 : 0);
+    }
+    
+    /*
+     the analyzer drains the ring DisplayRateHz times a second. The ring holds
+     RefreshesBuffered refreshes' worth of frames, so it survives a late or
+     missed refresh without growing with the block size.
+     */
+    static constexpr double DisplayRateHz = 60.0;
+    static constexpr double RefreshesBuffered = 3.0;
+    static constexpr int MinNumFrames = 4;
+    
+    static int getNumFrames(int frameSize, double sampleRate)
+    {
+        auto framesPerRefresh = sampleRate / (DisplayRateHz * juce::jmax(1, frameSize));
+        return juce::jmax(MinNumFrames, static_cast<int>(std::ceil(RefreshesBuffered * framesPerRefresh)));
+    }
+    
+    /*
+     each stage halves the rate, as long as the result stays at or above MinAnalysisRate.
+     */
+    static constexpr double MinAnalysisRate = 44100.0;
+    static constexpr int MaxDecimationStages = 3;
+    
+    static int getNumDecimationStages(double sampleRate)
+    {
+        int stages = 0;
+        while( stages < MaxDecimationStages && sampleRate / 2.0 >= MinAnalysisRate )
+        {
+            sampleRate /= 2.0;
+            ++stages;
+        }
+        return stages;
+    }
+    
+    /*
+     floats needed by prepare(): the staging lanes, the decimator history, then the ring.
+     */
+    size_t getStorageSize(const juce::dsp::ProcessSpec& spec) const
+    {
+        auto blockSize = static_cast<int>(spec.maximumBlockSize);
+        auto stages = getNumDecimationStages(spec.sampleRate);
+        
+        return getStagingSize(blockSize)
+             + getDecimatorStateSize(stages)
+             + getRingSize(getDecimatedSize(blockSize, stages), spec.sampleRate / (1 << stages));
+    }
+    
+    /*
+     'storage' must hold getStorageSize(spec) floats.
+     Waits for a reader that's in the middle of a ScopedReader.
+     */
+    void prepare(const juce::dsp::ProcessSpec& spec, float* storage)
+    {
+        const juce::SpinLock::ScopedLockType sl(readerLock);
+        prepared.set(false);
+        
+        maxBlockSize = static_cast<int>(spec.maximumBlockSize);
+        numDecimationStages = getNumDecimationStages(spec.sampleRate);
+        
+        auto newFrameSize = getDecimatedSize(maxBlockSize, numDecimationStages);
+        auto newSampleRate = spec.sampleRate / (1 << numDecimationStages);
+        
+        frameSize.set(newFrameSize);
+        numFrames.set(getNumFrames(newFrameSize, newSampleRate));
+        analysisRate.store(newSampleRate);
+        laneStride = DspArena::roundUp(static_cast<size_t>(maxBlockSize) * sizeof(float)) / sizeof(float);
+        
+        std::fill(storage, storage + getStorageSize(spec), 0.f);
+        
+        staging = storage;
+        storage += getStagingSize(maxBlockSize);
+        
+        if( numDecimationStages > 0 )
+            halfBand = HalfBandDecimator::Coefficients::design();
+        
+        for( auto& laneStages : decimators )
+        {
+            for( int stage = 0; stage < numDecimationStages; ++stage )
+            {
+                laneStages[(size_t)stage].prepare(storage);
+                storage += HalfBandDecimator::StateSize;
+            }
+        }
+        
+        ring = storage;
+        ringSize = getRingSize(newFrameSize, newSampleRate) / NumLanes;
+        
+        writeIndex.store(0);
+        readIndex.store(0);
+        prepared.set(true);
+    }
+    
+    /*
+     call before the memory passed to prepare() is freed or reused.
+     Waits for a reader that's in the middle of a ScopedReader, and
+     keeps everyone off the storage until the next prepare().
+     */
+    void releaseStorage()
+    {
+        const juce::SpinLock::ScopedLockType sl(readerLock);
+        prepared.set(false);
+        staging = nullptr;
+        ring = nullptr;
+    }
+    
+    /*
+     nothing is captured unless an analyzer is listening.
+     */
+    void setActive(bool shouldBeActive) { active.store(shouldBeActive); }
+    bool isActive() const { return active.load(std::memory_order_relaxed); }
+    
+    //==============================================================================
+    /*
+     audio thread, before the engine touches 'input'.
+     Returns false if nothing is to be captured this block.
+     */
+    bool beginBlock(const juce::AudioBuffer<float>& input)
+    {
+        blockSize = 0;
+        if( ! isActive() || ! prepared.get() )
+            return false;
+        
+        //the staging lanes hold a whole block; frameSize is what's left of one after decimation.
+        jassert(input.getNumSamples() <= maxBlockSize);
+        blockSize = juce::jmin(input.getNumSamples(), maxBlockSize);
+        
+        copyChannels(input, InputLeft);
+        
+        //bands that aren't produced this block, e.g. with the engine bypassed, read as silence.
+        for( int lane = FirstBandLane; lane < NumLanes; ++lane )
+            juce::FloatVectorOperations::clear(getLane(lane), blockSize);
+        
+        return true;
+    }
+    
+    /*
+     where the engine accumulates a lane this block, or nullptr if the tap is idle.
+     */
+    float* getStagingLane(int lane) { return blockSize > 0 ? getLane(lane) : nullptr; }
+    
+    /*
+     averages the channels of 'bandBuffer' into a band lane.
+     */
+    void captureBand(int band, bool afterCompressor, const juce::AudioBuffer<float>& bandBuffer)
+    {
+        if( blockSize == 0 )
+            return;
+        
+        auto* dest = getLane(getBandLane(band, afterCompressor));
+        auto numChannels = bandBuffer.getNumChannels();
+        auto weight = 1.f / static_cast<float>(juce::jmax(1, numChannels));
+        
+        for( int ch = 0; ch < numChannels; ++ch )
+            juce::FloatVectorOperations::addWithMultiply(dest, bandBuffer.getReadPointer(ch), weight, blockSize);
+    }
+    
+    /*
+     audio thread, once 'output' is final. If the reader has fallen so far
+     behind that the block doesn't fit, the whole block is dropped.
+     */
+    void endBlock(const juce::AudioBuffer<float>& output)
+    {
+        if( blockSize == 0 )
+            return;
+        
+        copyChannels(output, OutputLeft);
+        
+        auto numOut = decimate();
+        if( numOut == 0 )
+            return;
+        
+        auto numSamples = static_cast<juce::uint64>(numOut);
+        auto write = writeIndex.load(std::memory_order_relaxed);
+        auto read = readIndex.load(std::memory_order_acquire);
+        
+        if( write - read + numSamples > ringSize )
+        {
+            counters.noteDropped();
+            return;
+        }
+        
+        auto start = static_cast<int>(write % ringSize);
+        auto first = juce::jmin(numOut, static_cast<int>(ringSize) - start);
+        
+        interleave(0, first, ring + static_cast<size_t>(start) * NumLanes);
+        if( first < numOut )
+            interleave(first, numOut - first, ring);
+        
+        writeIndex.store(write + numSamples, std::memory_order_release);
+    }
+    
+    //==============================================================================
+    /*
+     the reader holds one of these around everything it does with the ring
+     and only reads if canRead(). prepare() and releaseStorage() wait for it,
+     so the storage is never replaced under a frame that's being read.
+     If the tap is being prepared right now, the reader just skips a turn.
+     */
+    struct ScopedReader
+    {
+        explicit ScopedReader(AnalysisTap& t) : tap(t), lock(t.readerLock) { }
+        
+        bool canRead() const { return lock.isLocked() && tap.isPrepared(); }
+    private:
+        AnalysisTap& tap;
+        const juce::SpinLock::ScopedTryLockType lock;
+    };
+    
+    /*
+     the oldest complete frame: getFrameSize() samples of NumLanes
+     interleaved floats, read in place until finishedReading().
+     Only inside a ScopedReader that canRead().
+     */
+    const float* getNextFrame()
+    {
+        auto found = getNumCompleteFramesAvailable() > 0;
+        counters.noteRead(found, writeIndex.load(std::memory_order_relaxed));
+        if( ! found )
+            return nullptr;
+        
+        return ring + (readIndex.load(std::memory_order_relaxed) % ringSize) * NumLanes;
+    }
+    
+    void finishedReading()
+    {
+        jassert(getNumCompleteFramesAvailable() > 0);
+        auto read = readIndex.load(std::memory_order_relaxed);
+        readIndex.store(read + static_cast<juce::uint64>(frameSize.get()), std::memory_order_release);
+    }
+    
+    /*
+     skips up to 'numFrames' of the oldest complete frames without reading them.
+     */
+    void discardFrames(int numFrames)
+    {
+        numFrames = juce::jmin(numFrames, getNumCompleteFramesAvailable());
+        if( numFrames <= 0 )
+            return;
+        
+        auto read = readIndex.load(std::memory_order_relaxed);
+        readIndex.store(read + static_cast<juce::uint64>(numFrames) * static_cast<juce::uint64>(frameSize.get()),
+                        std::memory_order_release);
+    }
+    
+    int getNumCompleteFramesAvailable() const
+    {
+        auto size = static_cast<juce::uint64>(frameSize.get());
+        if( size == 0 )
+            return 0;
+        
+        auto written = writeIndex.load(std::memory_order_acquire) / size;
+        auto read = readIndex.load(std::memory_order_relaxed) / size;
+        return static_cast<int>(written - read);
+    }
+    
+    /*
+     adds 'gain' times one lane of an interleaved frame to 'dest'.
+     */
+    static void addLane(const float* frame, int lane, float gain, float* dest, int numSamples)
+    {
+        for( int i = 0; i < numSamples; ++i )
+            dest[i] += gain * frame[i * NumLanes + lane];
+    }
+    
+    bool isPrepared() const { return prepared.get(); }
+    
+    /*
+     the sample rate of the frames, after any decimation.
+     */
+    double getSampleRate() const { return analysisRate.load(std::memory_order_relaxed); }
+    int getFrameSize() const { return frameSize.get(); }
+    int getNumFrames() const { return numFrames.get(); }
+    
+    /*
+     blocks dropped because the reader fell behind, and reads that found no new frame.
+     */
+    const FifoCounters& getCounters() const { return counters; }
+private:
+    //audio thread only.
+    float* staging = nullptr;
+    size_t laneStride = 0;
+    int maxBlockSize = 0;
+    int blockSize = 0;
+    
+    float* ring = nullptr;
+    juce::uint64 ringSize = 0;  //in samples per lane
+    
+    int numDecimationStages = 0;
+    HalfBandDecimator::Coefficients halfBand;
+    std::array<std::array<HalfBandDecimator, MaxDecimationStages>, NumLanes> decimators;
+    
+    /*
+     running sample counts, each written by one side only and kept on its
+     own cache line so the two threads don't fight over it.
+     */
+    alignas(64) std::atomic<juce::uint64> writeIndex { 0 };
+    alignas(64) std::atomic<juce::uint64> readIndex { 0 };
+    
+    juce::Atomic<bool> prepared = false;
+    juce::SpinLock readerLock;      //never taken by the audio thread
+    juce::Atomic<int> frameSize = 0;
+    juce::Atomic<int> numFrames = 0;
+    std::atomic<double> analysisRate { 0.0 };
+    std::atomic<bool> active { false };
+    
+    FifoCounters counters;
+    
+    static size_t getStagingSize(int frameSize)
+    {
+        return NumLanes * DspArena::roundUp(static_cast<size_t>(frameSize) * sizeof(float)) / sizeof(float);
+    }
+    
+    static size_t getDecimatorStateSize(int stages)
+    {
+        return static_cast<size_t>(NumLanes * stages) * HalfBandDecimator::StateSize;
+    }
+    
+    /*
+     the most samples a block of 'numSamples' can leave after 'stages' halvings,
+     whatever the phase of the decimators.
+     */
+    static int getDecimatedSize(int numSamples, int stages)
+    {
+        for( int stage = 0; stage < stages; ++stage )
+            numSamples = (numSamples + 1) / 2;
+        return numSamples;
+    }
+    
+    static size_t getRingSize(int frameSize, double sampleRate)
+    {
+        return static_cast<size_t>(getNumFrames(frameSize, sampleRate)) * static_cast<size_t>(frameSize) * NumLanes;
+    }
+    
+    float* getLane(int lane) { return staging + static_cast<size_t>(lane) * laneStride; }
+    
+    /*
+     a mono buffer fills both the left and the right lane.
+     */
+    void copyChannels(const juce::AudioBuffer<float>& buffer, int leftLane)
+    {
+        auto numChannels = buffer.getNumChannels();
+        if( numChannels == 0 )
+        {
+            juce::FloatVectorOperations::clear(getLane(leftLane), blockSize);
+            juce::FloatVectorOperations::clear(getLane(leftLane + 1), blockSize);
+            return;
+        }
+        
+        juce::FloatVectorOperations::copy(getLane(leftLane), buffer.getReadPointer(0), blockSize);
+        juce::FloatVectorOperations::copy(getLane(leftLane + 1), buffer.getReadPointer(juce::jmin(1, numChannels - 1)), blockSize);
+    }
+    
+    /*
+     decimates every staged lane in place. All the lanes share the same phase,
+     so they all come out the same length.
+     */
+    int decimate()
+    {
+        auto numOut = blockSize;
+        for( int lane = 0; lane < NumLanes; ++lane )
+        {
+            numOut = blockSize;
+            for( int stage = 0; stage < numDecimationStages; ++stage )
+                numOut = decimators[(size_t)lane][(size_t)stage].process(getLane(lane), numOut, halfBand);
+        }
+        return numOut;
+    }
+    
+    void interleave(int offset, int numSamples, float* dest)
+    {
+        const float* lanes[NumLanes];
+        for( int lane = 0; lane < NumLanes; ++lane )
+            lanes[lane] = getLane(lane) + offset;
+        
+        for( int i = 0; i < numSamples; ++i )
+        {
+            for( int lane = 0; lane < NumLanes; ++lane )
+                dest[lane] = lanes[lane][i];
+            
+            dest += NumLanes;
+        }
+    }
+};
@@ -1,46 +1,118 @@
-/*
-  ==============================================================================
-
-    CompressorBand.cpp
-    Created: 13 May 2024 5:27:58pm
-    Author:  Marc Woodbury-Smith
-
-  ==============================================================================
-*/
-
-#include "CompressorBand.h"
-
-void CompressorBand::prepare(const juce::dsp::ProcessSpec& spec)
-{
-    compressor.prepare(spec);
-}
-
-void CompressorBand::updateCompressorSettings()
-{
-    compressor.setAttack(attack->get());
-    compressor.setRelease(release->get());
-    compressor.setThreshold(threshold->get());
-    compressor.setRatio(ratio->getCurrentChoiceName().getFloatValue());
-}
-
-void CompressorBand::process(juce::AudioBuffer<float>& buffer)
-{
-    auto preRMS = computeRMSLevel(buffer);
-    
-    auto block = juce::dsp::AudioBlock<float>(buffer);
-
-    auto context = juce::dsp::ProcessContextReplacing<float>(block);
-
-    context.isBypassed = bypassed->get();
-
-    compressor.process(context);
-    
-    auto postRMS = computeRMSLevel(buffer);
-    
-    auto convertToDb = [](auto input){ return juce::Decibels::gainToDecibels(input); };
-    
-    rmsInputLevelDb.store(convertToDb(preRMS));
-    rmsOutputLevelDb.store(convertToDb(postRMS));
-
-}
-
+/*
+  ==============================================================================
+
+    CompressorBand.cpp
+    Created: 13 May 2024 5:27:58pm
+    Author:  Marc Woodbury-Smith
+
+  ==============================================================================
+*/
+
+#include "CompressorBand.h"
+
+void CompressorBand::prepare(const juce::dsp::ProcessSpec& spec, float* stateMemory)
+{
+    envelope = stateMemory;
+    numChannels = static_cast<int>(spec.numChannels);
+    
+    releaseTable = envelope + numChannels;
+    releaseTableSize = static_cast<int>(getReleaseTableSize(spec));
+    coefficients.releasePowers = releaseTable;
+    coefficients.numReleasePowers = releaseTableSize;
+    expFactor = -2.0 * juce::MathConstants<double>::pi * 1000.0 / spec.sampleRate;
+    
+    //the time constants depend on the sample rate, and the coefficients start from scratch.
+    lastAttack = lastRelease = lastThreshold = lastRatio = Unset;
+    updateCompressorSettings();
+    
+    reset();
+}
+
+void CompressorBand::updateCompressorSettings()
+{
+    if( attack == nullptr )
+        return;
+    
+    /*
+     same ballistics and gain computer as juce::dsp::Compressor, but only
+     recalculated when a parameter actually changes.
+     */
+    auto calculateLimitedCte = [this](float timeMs)
+    {
+        return timeMs < 1.0e-3f ? 0.f : static_cast<float>(std::exp(expFactor / timeMs));
+    };
+    
+    if( auto a = attack->get(); a != lastAttack )
+    {
+        lastAttack = a;
+        coefficients.cteAT = calculateLimitedCte(a);
+    }
+    
+    if( auto r = release->get(); r != lastRelease )
+    {
+        lastRelease = r;
+        coefficients.cteRL = calculateLimitedCte(r);
+        
+        if( releaseTable != nullptr )
+        {
+            releaseTable[0] = 1.f;
+            for( int k = 1; k < releaseTableSize; ++k )
+                releaseTable[k] = releaseTable[k - 1] * coefficients.cteRL;
+        }
+    }
+    
+    if( auto t = threshold->get(); t != lastThreshold )
+    {
+        lastThreshold = t;
+        coefficients.threshold = juce::Decibels::decibelsToGain(t, -200.f);
+        coefficients.thresholdInverse = 1.f / coefficients.threshold;
+    }
+    
+    if( auto r = ratio->getCurrentChoiceName().getFloatValue(); r != lastRatio )
+    {
+        jassert(r >= 1.f);
+        lastRatio = r;
+        coefficients.ratioInverse = 1.f / r;
+    }
+}
+
+void CompressorBand::storeLevels(float preRMS, float postRMS)
+{
+    auto convertToDb = [](auto input){ return juce::Decibels::gainToDecibels(input); };
+    
+    rmsInputLevelDb.store(convertToDb(preRMS));
+    rmsOutputLevelDb.store(convertToDb(postRMS));
+}
+
+void CompressorBand::updateLevels(const float* inputSumSquares,
+                                  const float* outputSumSquares,
+                                  int channels,
+                                  int numSamples)
+{
+    if( channels <= 0 || numSamples <= 0 )
+        return;
+    
+    //same as computeRMSLevel(): the mean of the per-channel RMS levels.
+    auto preRMS = 0.f, postRMS = 0.f;
+    for( int ch = 0; ch < channels; ++ch )
+    {
+        preRMS += std::sqrt(inputSumSquares[ch] / static_cast<float>(numSamples));
+        postRMS += std::sqrt(outputSumSquares[ch] / static_cast<float>(numSamples));
+    }
+    
+    storeLevels(preRMS / static_cast<float>(channels), postRMS / static_cast<float>(channels));
+}
+
+void CompressorBand::reset()
+{
+    if( envelope != nullptr )
+        std::fill(envelope, envelope + numChannels, 0.f);
+    
+    clearLevels();
+}
+
+void CompressorBand::clearLevels()
+{
+    rmsInputLevelDb.store(NEGATIVE_INFINITY);
+    rmsOutputLevelDb.store(NEGATIVE_INFINITY);
+}
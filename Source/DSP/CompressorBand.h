@@ -1,62 +1,156 @@
-/*
-  ==============================================================================
-
-    CompressorBand.h
-    Created: 13 May 2024 5:27:58pm
-    Author:  Marc Woodbury-Smith
-
-  ==============================================================================
-*/
-
-#pragma once
-#include <JuceHeader.h>
-#include "../GUI/Utilities.h"
-
-//==============================================================================
-struct CompressorBand
-{
-    juce::AudioParameterFloat* attack { nullptr };
-    juce::AudioParameterFloat* release { nullptr };
-    juce::AudioParameterFloat* threshold { nullptr };
-    juce::AudioParameterChoice* ratio { nullptr };
-    
-    juce::AudioParameterBool* bypassed { nullptr };
-    juce::AudioParameterBool* mute { nullptr };
-    juce::AudioParameterBool* solo { nullptr };
-    
-    void prepare(const juce::dsp::ProcessSpec& spec);
-    
-    
-    void updateCompressorSettings();
-    
-    
-    void process(juce::AudioBuffer<float>& buffer);
-    
-    float getRMSOutputLevelDb() const { return rmsOutputLevelDb; }
-    float getRMSInputLevelDb() const { return rmsInputLevelDb; }
-
-    
-private:
-    
-    juce::dsp::Compressor<float> compressor;
-    
-    std::atomic<float> rmsInputLevelDb { NEGATIVE_INFINITY };
-    std::atomic<float> rmsOutputLevelDb { NEGATIVE_INFINITY };
-    
-    template<typename T>
-    float computeRMSLevel(const T& buffer)
-    {
-        int numChannels = static_cast<int>(buffer.getNumChannels());
-        int numSamples = static_cast<int>(buffer.getNumSamples());
-        auto rms = 0.f;
-        for( int chan = 0; chan < numChannels; ++chan )
-        {
-            rms += buffer.getRMSLevel(chan, 0, numSamples);
-        }
-        
-        rms /= static_cast<float>(numChannels);
-        return rms;
-    }
-};
-
-
+/*
+  ==============================================================================
+
+    CompressorBand.h
+    Created: 13 May 2024 5:27:58pm
+    Author:  Marc Woodbury-Smith
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "../GUI/Utilities.h"
+#include "KernelDispatch.h"
+
+//==============================================================================
+struct CompressorBand
+{
+    juce::AudioParameterFloat* attack { nullptr };
+    juce::AudioParameterFloat* release { nullptr };
+    juce::AudioParameterFloat* threshold { nullptr };
+    juce::AudioParameterChoice* ratio { nullptr };
+    
+    juce::AudioParameterBool* bypassed { nullptr };
+    juce::AudioParameterBool* mute { nullptr };
+    juce::AudioParameterBool* solo { nullptr };
+    
+    /*
+     floats needed for an envelope per channel and the release table.
+     */
+    static size_t getStateSize(const juce::dsp::ProcessSpec& spec)
+    {
+        return static_cast<size_t>(spec.numChannels) + getReleaseTableSize(spec);
+    }
+    
+    void prepare(const juce::dsp::ProcessSpec& spec, float* stateMemory);
+    
+    
+    void updateCompressorSettings();
+    
+    
+    /*
+     NumChannels > 0 selects the kernel specialised for exactly that many channels,
+     0 handles any channel count one channel at a time.
+     */
+    template<int NumChannels = 0>
+    void process(juce::AudioBuffer<float>& buffer)
+    {
+        auto preRMS = computeRMSLevel(buffer);
+        auto touched = false;
+        
+        /*
+         like juce::dsp::Compressor, a bypassed band passes through and its envelope holds.
+         */
+        if( ! bypassed->get() )
+        {
+            static_assert(NumChannels < KernelDispatch::KernelSet::NumSpecialisations, "no kernel for that many channels");
+            jassert(envelope != nullptr);
+            
+            auto channels = NumChannels > 0 ? NumChannels : juce::jmin(buffer.getNumChannels(), numChannels);
+            jassert(buffer.getNumChannels() >= channels && numChannels >= channels);
+            
+            touched = KernelDispatch::get().compress[NumChannels](buffer.getArrayOfWritePointers(),
+                                                                  envelope,
+                                                                  coefficients,
+                                                                  channels,
+                                                                  buffer.getNumSamples());
+        }
+        
+        //a block below the threshold comes out as it went in.
+        storeLevels(preRMS, touched ? computeRMSLevel(buffer) : preRMS);
+    }
+    
+    /*
+     this band's part of the fused engine. The caller fills in the mask and
+     the sum-of-squares pointers, then hands the sums back to updateLevels().
+     */
+    Kernels::FusedBand getFusedBand() const
+    {
+        Kernels::FusedBand band;
+        band.coefficients = coefficients;
+        band.envelopes = envelope;
+        band.compress = ! bypassed->get();
+        return band;
+    }
+    
+    void updateLevels(const float* inputSumSquares,
+                      const float* outputSumSquares,
+                      int numChannels,
+                      int numSamples);
+    
+    /*
+     clears the envelope and drops the level meters to -inf.
+     */
+    void reset();
+    
+    /*
+     drops the level meters to -inf, for when nothing measures this band.
+     */
+    void clearLevels();
+    
+    float getRMSOutputLevelDb() const { return rmsOutputLevelDb; }
+    float getRMSInputLevelDb() const { return rmsInputLevelDb; }
+
+    
+private:
+    
+    /*
+     the detector and gain computer of juce::dsp::Compressor, with the envelope
+     living in memory handed over by the processor.
+     */
+    Kernels::CompressorCoefficients coefficients;
+    float* envelope = nullptr;
+    int numChannels = 0;
+    double expFactor = 0.0;
+    
+    /*
+     cteRL^k for every block length, rebuilt when the release time changes.
+     */
+    float* releaseTable = nullptr;
+    int releaseTableSize = 0;
+    
+    static size_t getReleaseTableSize(const juce::dsp::ProcessSpec& spec)
+    {
+        return static_cast<size_t>(spec.maximumBlockSize) + 1;
+    }
+    
+    /*
+     none of the parameters can ever take this value, so the first
+     updateCompressorSettings() after prepare() sets everything.
+     */
+    static constexpr float Unset = -1000.f;
+    float lastAttack = Unset, lastRelease = Unset, lastThreshold = Unset, lastRatio = Unset;
+    
+    void storeLevels(float preRMS, float postRMS);
+    
+    std::atomic<float> rmsInputLevelDb { NEGATIVE_INFINITY };
+    std::atomic<float> rmsOutputLevelDb { NEGATIVE_INFINITY };
+    
+    template<typename T>
+    float computeRMSLevel(const T& buffer)
+    {
+        int numChannels = static_cast<int>(buffer.getNumChannels());
+        int numSamples = static_cast<int>(buffer.getNumSamples());
+        auto rms = 0.f;
+        for( int chan = 0; chan < numChannels; ++chan )
+        {
+            rms += buffer.getRMSLevel(chan, 0, numSamples);
+        }
+        
+        rms /= static_cast<float>(numChannels);
+        return rms;
+    }
+};
+
+
@@ -0,0 +1,74 @@
+/*
+  ==============================================================================
+
+    Crossover.cpp
+    Created: 19 Oct 2026 5:48:33pm
+    Author:  Marc Woodbury-Smith
+
+  ==============================================================================
+*/
+
+#include "Crossover.h"
+
+void Crossover::prepare(const juce::dsp::ProcessSpec& spec, float* stateMemory)
+{
+    sampleRate = spec.sampleRate;
+    numChannels = static_cast<int>(spec.numChannels);
+    state = stateMemory;
+    
+    //force the coefficients to be recalculated for the new sample rate.
+    auto previous = cutoffs;
+    resetCutoffs();
+    for( int c = 0; c < NumCrossovers; ++c )
+    {
+        if( previous[(size_t)c] > 0.f )
+            setCutoffFrequency(c, previous[(size_t)c]);
+    }
+    
+    reset();
+}
+
+void Crossover::setCutoffFrequency(int crossoverIndex, float frequency)
+{
+    jassert(juce::isPositiveAndBelow(crossoverIndex, NumCrossovers));
+    auto index = static_cast<size_t>(crossoverIndex);
+    
+    /*
+     tan() is the expensive part, so only recalculate when a crossover actually moves.
+     */
+    if( frequency != cutoffs[index] )
+    {
+        cutoffs[index] = frequency;
+        coefficients[index] = Kernels::LinkwitzRileyCoefficients::make(frequency, sampleRate);
+    }
+}
+
+void Crossover::reset()
+{
+    if( state != nullptr )
+        std::fill(state, state + getStateSize(numChannels), 0.f);
+}
+
+void Crossover::seedAllpass()
+{
+    jassert(state != nullptr);
+    
+    auto* allpassState = getAllpassState();
+    for( int ch = 0; ch < numChannels; ++ch )
+    {
+        DspGraph::Topology::getAllpassState(state + ch * Kernels::NumCrossoverStates,
+                                            allpassState + ch * DspGraph::NumAllpassStates);
+    }
+}
+
+void Crossover::seedCrossover()
+{
+    jassert(state != nullptr);
+    
+    const auto* allpassState = getAllpassState();
+    for( int ch = 0; ch < numChannels; ++ch )
+    {
+        DspGraph::Topology::setFromAllpassState(allpassState + ch * DspGraph::NumAllpassStates,
+                                                state + ch * Kernels::NumCrossoverStates);
+    }
+}
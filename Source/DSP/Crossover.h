@@ -0,0 +1,166 @@
+/*
+  ==============================================================================
+
+    Crossover.h
+    Created: 19 Oct 2026 5:48:33pm
+    Author:  Marc Woodbury-Smith
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "KernelDispatch.h"
+
+/*
+ The crossover tree declared by DspGraph::Topology as a single unit.
+ It doesn't own its filter state: prepare() is given memory for
+ getStateSize() floats, so the state can sit next to the rest of the
+ audio-thread data.
+ */
+struct Crossover
+{
+    static constexpr int NumBands = DspGraph::NumBands;
+    static constexpr int NumCrossovers = DspGraph::NumCrossovers;
+    
+    using BandBuffers = std::array<juce::AudioBuffer<float>, NumBands>;
+    
+    Crossover() { resetCutoffs(); }
+    
+    static size_t getStateSize(int numChannels)
+    {
+        return static_cast<size_t>(numChannels) * (Kernels::NumCrossoverStates + DspGraph::NumAllpassStates);
+    }
+    
+    void prepare(const juce::dsp::ProcessSpec& spec, float* stateMemory);
+    
+    /*
+     crossover 0 is the lowest.
+     */
+    void setCutoffFrequency(int crossoverIndex, float frequency);
+    
+    void reset();
+    
+    float getLowestCutoff() const { return cutoffs[0]; }
+    
+    /*
+     reads 'input' once, applying the gain ramp on the way in, and writes every band.
+     NumChannels > 0 selects the kernel specialised for exactly that many channels,
+     0 handles any channel count one channel at a time.
+     */
+    template<int NumChannels = 0>
+    void process(const juce::AudioBuffer<float>& input,
+                 const float* gainRamp,
+                 float gain,
+                 BandBuffers& bands)
+    {
+        static_assert(NumChannels < KernelDispatch::KernelSet::NumSpecialisations, "no kernel for that many channels");
+        jassert(state != nullptr);
+        
+        auto channels = NumChannels > 0 ? NumChannels : juce::jmin(input.getNumChannels(), numChannels);
+        jassert(input.getNumChannels() >= channels && numChannels >= channels);
+        
+        std::array<float* const*, NumBands> bandChannels;
+        for( size_t b = 0; b < bands.size(); ++b )
+            bandChannels[b] = bands[b].getArrayOfWritePointers();
+        
+        KernelDispatch::get().splitBands[NumChannels](input.getArrayOfReadPointers(),
+                                                      gainRamp,
+                                                      gain,
+                                                      bandChannels.data(),
+                                                      state,
+                                                      coefficients.data(),
+                                                      channels,
+                                                      input.getNumSamples());
+    }
+    
+    /*
+     the whole engine in one pass: input gain, this crossover, the band
+     compressors, masked sum and output gain, written back into 'io'.
+     'bands' has NumBands entries.
+     */
+    template<int NumChannels = 0>
+    void processFused(juce::AudioBuffer<float>& io,
+                      const float* inputRamp,
+                      float inputGain,
+                      const float* outputRamp,
+                      float outputGain,
+                      const Kernels::FusedBand* bands)
+    {
+        static_assert(NumChannels < KernelDispatch::KernelSet::NumSpecialisations, "no kernel for that many channels");
+        jassert(state != nullptr);
+        
+        auto channels = NumChannels > 0 ? NumChannels : juce::jmin(io.getNumChannels(), numChannels);
+        jassert(io.getNumChannels() >= channels && numChannels >= channels);
+        
+        KernelDispatch::get().processFused[NumChannels](io.getArrayOfWritePointers(),
+                                                        inputRamp,
+                                                        inputGain,
+                                                        outputRamp,
+                                                        outputGain,
+                                                        state,
+                                                        coefficients.data(),
+                                                        bands,
+                                                        channels,
+                                                        io.getNumSamples());
+    }
+    
+    /*
+     what process() followed by an unmasked sum comes to when nothing is done
+     to the bands: the allpass chain of the crossovers, with the same gains.
+     It keeps its own state, see seedAllpass() and seedCrossover().
+     'output' may be 'input'.
+     */
+    template<int NumChannels = 0>
+    void processAllpass(const juce::AudioBuffer<float>& input,
+                        juce::AudioBuffer<float>& output,
+                        const float* inputRamp,
+                        float inputGain,
+                        const float* outputRamp,
+                        float outputGain)
+    {
+        static_assert(NumChannels < KernelDispatch::KernelSet::NumSpecialisations, "no kernel for that many channels");
+        jassert(state != nullptr);
+        
+        auto channels = NumChannels > 0 ? NumChannels : juce::jmin(input.getNumChannels(), numChannels);
+        jassert(input.getNumChannels() >= channels && output.getNumChannels() >= channels && numChannels >= channels);
+        jassert(output.getNumSamples() >= input.getNumSamples());
+        
+        KernelDispatch::get().allpass[NumChannels](input.getArrayOfReadPointers(),
+                                                   output.getArrayOfWritePointers(),
+                                                   inputRamp,
+                                                   inputGain,
+                                                   outputRamp,
+                                                   outputGain,
+                                                   getAllpassState(),
+                                                   coefficients.data(),
+                                                   channels,
+                                                   input.getNumSamples());
+    }
+    
+    /*
+     hands over from the crossover to the allpass. Exact, see DspGraph::Split::getAllpassState().
+     */
+    void seedAllpass();
+    
+    /*
+     hands back from the allpass to the crossover. Only the first stages can be
+     recovered, the rest starts from zero.
+     */
+    void seedCrossover();
+private:
+    double sampleRate = 44100.0;
+    int numChannels = 0;
+    float* state = nullptr;
+    
+    std::array<float, NumCrossovers> cutoffs;
+    std::array<Kernels::LinkwitzRileyCoefficients, NumCrossovers> coefficients;
+    
+    //a cutoff nobody has set yet.
+    static constexpr float Unset = -1.f;
+    
+    void resetCutoffs() { cutoffs.fill(Unset); }
+    
+    //the allpass state follows the crossover state of every channel.
+    float* getAllpassState() const { return state + static_cast<size_t>(numChannels) * Kernels::NumCrossoverStates; }
+};
@@ -0,0 +1,184 @@
+/*
+  ==============================================================================
+
+    DeadlineMonitor.h
+    Created: 19 Oct 2026 1:36:15pm
+    Author:  Marc Woodbury-Smith
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+#include <array>
+
+/*
+ Compares the wall time of every processBlock() call with the real-time budget
+ of that block (numSamples / sampleRate).
+ The audio thread is the only writer. The utilisation of the most recent
+ blocks is kept in a ring that the message thread can read without locking.
+ */
+struct DeadlineMonitor
+{
+    static constexpr int RingSize = 512;
+
+    enum Threshold
+    {
+        Over50Percent,
+        Over80Percent,
+        Over100Percent,
+        NumThresholds
+    };
+
+    struct Snapshot
+    {
+        juce::uint64 numBlocks = 0;
+        std::array<juce::uint64, NumThresholds> numBlocksOver {};
+        float peakUtilisation = 0.f;
+
+        //over the blocks still held in the ring
+        float recentMeanUtilisation = 0.f;
+        float recentMaxUtilisation = 0.f;
+
+        Snapshot& operator+=(const Snapshot& other)
+        {
+            auto total = numBlocks + other.numBlocks;
+            if( total > 0 )
+            {
+                recentMeanUtilisation = static_cast<float>((recentMeanUtilisation * numBlocks
+                                                            + other.recentMeanUtilisation * other.numBlocks) / total);
+            }
+
+            numBlocks = total;
+            for( size_t i = 0; i < numBlocksOver.size(); ++i )
+                numBlocksOver[i] += other.numBlocksOver[i];
+
+            peakUtilisation = juce::jmax(peakUtilisation, other.peakUtilisation);
+            recentMaxUtilisation = juce::jmax(recentMaxUtilisation, other.recentMaxUtilisation);
+            return *this;
+        }
+
+        juce::String toString() const
+        {
+            auto percent = [](float utilisation) { return juce::String(100.f * utilisation, 1) + "%"; };
+
+            juce::String str;
+            str << "blocks: " << (juce::int64)numBlocks
+                << ", recent mean " << percent(recentMeanUtilisation)
+                << ", recent max " << percent(recentMaxUtilisation)
+                << ", peak " << percent(peakUtilisation) << juce::newLine;
+            str << "over 50%: " << (juce::int64)numBlocksOver[Over50Percent]
+                << ", over 80%: " << (juce::int64)numBlocksOver[Over80Percent]
+                << ", over 100%: " << (juce::int64)numBlocksOver[Over100Percent] << juce::newLine;
+            return str;
+        }
+    };
+
+    //==============================================================================
+    struct ScopedBlock
+    {
+        ScopedBlock(DeadlineMonitor& m, int n) :
+        monitor(m),
+        numSamples(n),
+        startTicks(juce::Time::getHighResolutionTicks())
+        { }
+
+        ~ScopedBlock()
+        {
+            monitor.record(juce::Time::getHighResolutionTicks() - startTicks, numSamples);
+        }
+    private:
+        DeadlineMonitor& monitor;
+        int numSamples;
+        juce::int64 startTicks;
+    };
+
+    //==============================================================================
+    void prepare(double sampleRate)
+    {
+        secondsPerSample = sampleRate > 0.0 ? 1.0 / sampleRate : 0.0;
+    }
+
+    void requestReset() { resetRequested.store(true); }
+
+    void record(juce::int64 elapsedTicks, int numSamples)
+    {
+        if( numSamples <= 0 || secondsPerSample <= 0.0 )
+            return;
+
+        if( resetRequested.exchange(false) )
+        {
+            numBlocks.store(0, std::memory_order_relaxed);
+            for( auto& count : numBlocksOver )
+                count.store(0, std::memory_order_relaxed);
+            peakUtilisation.store(0.f, std::memory_order_relaxed);
+        }
+
+        auto budget = numSamples * secondsPerSample;
+        auto utilisation = static_cast<float>(juce::Time::highResolutionTicksToSeconds(elapsedTicks) / budget);
+
+        auto bump = [](auto& counter)
+        {
+            counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        };
+
+        if( utilisation > 0.5f )
+            bump(numBlocksOver[Over50Percent]);
+        if( utilisation > 0.8f )
+            bump(numBlocksOver[Over80Percent]);
+        if( utilisation > 1.f )
+            bump(numBlocksOver[Over100Percent]);
+
+        if( utilisation > peakUtilisation.load(std::memory_order_relaxed) )
+            peakUtilisation.store(utilisation, std::memory_order_relaxed);
+
+        auto index = numBlocks.load(std::memory_order_relaxed);
+        ring[(size_t)(index % RingSize)].store(utilisation, std::memory_order_relaxed);
+        numBlocks.store(index + 1, std::memory_order_release);
+    }
+
+    Snapshot getSnapshot() const
+    {
+        Snapshot snapshot;
+        snapshot.numBlocks = numBlocks.load(std::memory_order_acquire);
+        for( size_t i = 0; i < numBlocksOver.size(); ++i )
+            snapshot.numBlocksOver[i] = numBlocksOver[i].load(std::memory_order_relaxed);
+        snapshot.peakUtilisation = peakUtilisation.load(std::memory_order_relaxed);
+
+        auto numRecent = static_cast<int>(juce::jmin(snapshot.numBlocks, (juce::uint64)RingSize));
+        auto sum = 0.f;
+        for( int i = 0; i < numRecent; ++i )
+        {
+            auto u = ring[(size_t)i].load(std::memory_order_relaxed);
+            sum += u;
+            snapshot.recentMaxUtilisation = juce::jmax(snapshot.recentMaxUtilisation, u);
+        }
+
+        if( numRecent > 0 )
+            snapshot.recentMeanUtilisation = sum / static_cast<float>(numRecent);
+
+        return snapshot;
+    }
+
+    /*
+     copies the utilisation of the most recent blocks, oldest first.
+     */
+    int getRecentUtilisation(float* dest, int maxNum) const
+    {
+        auto end = numBlocks.load(std::memory_order_acquire);
+        auto num = static_cast<int>(juce::jmin(end, (juce::uint64)juce::jmin(maxNum, RingSize)));
+        for( int i = 0; i < num; ++i )
+            dest[i] = ring[(size_t)((end - (juce::uint64)num + (juce::uint64)i) % RingSize)].load(std::memory_order_relaxed);
+        return num;
+    }
+private:
+    double secondsPerSample = 0.0;
+
+    std::array<std::atomic<float>, RingSize> ring {};
+    std::atomic<juce::uint64> numBlocks { 0 };
+    std::array<std::atomic<juce::uint64>, NumThresholds> numBlocksOver {};
+    std::atomic<float> peakUtilisation { 0.f };
+
+    std::atomic<bool> resetRequested { false };
+};
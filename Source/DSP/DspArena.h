@@ -0,0 +1,83 @@
+/*
+  ==============================================================================
+
+    DspArena.h
+    Created: 19 Oct 2026 5:48:33pm
+    Author:  Marc Woodbury-Smith
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/*
+ One cache-line aligned block of memory that the real-time buffers and
+ filter state are carved from, in the order they're used.
+ Every carve starts on its own 64-byte line, so two pieces never share a line.
+ 
+ allocate() and carve() are for prepareToPlay() only, never the audio thread.
+ allocate() may free the previous memory, so anything another thread reads
+ from the arena has to be kept off it first (see AnalysisTap::releaseStorage()).
+ */
+struct DspArena
+{
+    static constexpr size_t Alignment = 64;
+    
+    static constexpr size_t roundUp(size_t numBytes)
+    {
+        return (numBytes + Alignment - 1) & ~(Alignment - 1);
+    }
+    
+    template<typename T>
+    static constexpr size_t bytesFor(size_t count)
+    {
+        return roundUp(count * sizeof(T));
+    }
+    
+    /*
+     forgets everything carved so far and makes sure there's room for numBytes.
+     The memory is zeroed.
+     */
+    void allocate(size_t numBytes)
+    {
+        if( numBytes > capacity )
+        {
+            storage.allocate(numBytes + Alignment, false);
+            capacity = numBytes;
+        }
+        
+        auto address = static_cast<size_t>(reinterpret_cast<juce::pointer_sized_uint>(storage.get()));
+        base = storage.get() + (roundUp(address) - address);
+        
+        std::fill(base, base + capacity, char(0));
+        used = 0;
+    }
+    
+    /*
+     returns nullptr if the layout and the size passed to allocate() don't
+     agree. The caller has to check, and must not process with anything
+     carved after a failure.
+     */
+    template<typename T>
+    T* carve(size_t count)
+    {
+        auto numBytes = bytesFor<T>(count);
+        if( used + numBytes > capacity )
+        {
+            jassertfalse; //the layout and the size passed to allocate() don't agree!
+            return nullptr;
+        }
+        
+        auto* ptr = reinterpret_cast<T*>(base + used);
+        used += numBytes;
+        return ptr;
+    }
+    
+    size_t getNumBytesUsed() const { return used; }
+private:
+    juce::HeapBlock<char> storage;
+    char* base = nullptr;
+    size_t capacity = 0;
+    size_t used = 0;
+};
@@ -0,0 +1,201 @@
+/*
+  ==============================================================================
+
+    DspGraph.h
+    Created: 19 Oct 2026 9:47:18pm
+    Author:  Marc Woodbury-Smith
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/*
+ The band-splitting topology of the processor, declared as a type.
+ 
+ Split<C, Low, High> is a Linkwitz-Riley crossover at crossover frequency C
+ that feeds its lowpass into 'Low' and its highpass into 'High'.
+ Band<B> is where band B leaves the tree (fan-in happens in the Sink).
+ Everything about the tree is worked out at compile time:
+ - the number of bands, crossovers and state floats,
+ - where each node's state lives,
+ - the allpasses the low side of a split needs so every band stays in phase
+   with the bands split off further up.
+ 
+ A node processes one sample at a time and hands every band it produces to
+ sink.template band<B>(value), so the whole tree inlines into whatever loop
+ drives it.
+ */
+namespace DspGraph
+{
+/*
+ one Linkwitz-Riley section is two identical TPT state-variable filters in series.
+ The maths is the same as juce::dsp::LinkwitzRileyFilter.
+ */
+struct LinkwitzRileyCoefficients
+{
+    float g = 0.f, R2 = 0.f, h = 0.f;
+    
+    static LinkwitzRileyCoefficients make(float cutoffFrequency, double sampleRate)
+    {
+        LinkwitzRileyCoefficients c;
+        c.g = (float) std::tan(juce::MathConstants<double>::pi * cutoffFrequency / sampleRate);
+        c.R2 = (float) std::sqrt(2.0);
+        c.h = (float) (1.0 / (1.0 + c.R2 * c.g + c.g * c.g));
+        return c;
+    }
+};
+
+JUCE_FORCEINLINE void svfTick(float x,
+                              float& s1,
+                              float& s2,
+                              const LinkwitzRileyCoefficients& c,
+                              float& yL,
+                              float& yB,
+                              float& yH)
+{
+    //locals first: callers pass the same variable for outputs they don't need.
+    auto h = (x - (c.R2 + c.g) * s1 - s2) * c.h;
+    
+    auto b = c.g * h + s1;
+    s1 = c.g * h + b;
+    
+    auto l = c.g * b + s2;
+    s2 = c.g * b + l;
+    
+    yL = l;
+    yB = b;
+    yH = h;
+}
+
+//==============================================================================
+template<int B>
+struct Band
+{
+    static constexpr int NumBands = 1;
+    static constexpr int NumCrossovers = 0;
+    static constexpr int NumStates = 0;
+    
+    static JUCE_FORCEINLINE float allpass(float x, float*, const LinkwitzRileyCoefficients*) { return x; }
+    
+    static void getAllpassState(const float*, float*) { }
+    static void setFromAllpassState(const float*, float*) { }
+    
+    template<typename Sink>
+    static JUCE_FORCEINLINE void process(float x, float*, const LinkwitzRileyCoefficients*, Sink& sink)
+    {
+        sink.template band<B>(x);
+    }
+};
+
+/*
+ state layout: the first SVF stage shared by LP and HP (the same input and
+ coefficients give them identical state), the second LP stage, the second HP
+ stage, the allpasses for the low side, then Low's state, then High's.
+ */
+template<int C, typename Low, typename High>
+struct Split
+{
+    static constexpr int NumBands = Low::NumBands + High::NumBands;
+    static constexpr int NumCrossovers = 1 + Low::NumCrossovers + High::NumCrossovers;
+    
+    static constexpr int AllpassOffset = 6;
+    static constexpr int LowOffset = AllpassOffset + 2 * High::NumCrossovers;
+    static constexpr int HighOffset = LowOffset + Low::NumStates;
+    static constexpr int NumStates = HighOffset + High::NumStates;
+    
+    /*
+     this split's crossover and everything below it, as allpasses:
+     what a parallel branch has to go through to stay in phase.
+     */
+    static JUCE_FORCEINLINE float allpass(float x, float* s, const LinkwitzRileyCoefficients* c)
+    {
+        float yL, yB, yH;
+        svfTick(x, s[0], s[1], c[C], yL, yB, yH);
+        x = yL - c[C].R2 * yB + yH;
+        
+        x = Low::allpass(x, s + 2, c);
+        return High::allpass(x, s + 2 + 2 * Low::NumCrossovers, c);
+    }
+    
+    /*
+     when nothing is done to the bands, this node's output sums to allpass(input).
+     getAllpassState() fills in the 2 * NumCrossovers floats of state that allpass()
+     would have if it had been running on the same input all along, so it can take
+     over without a discontinuity:
+     - an allpass SVF and the shared first stage are the same filter fed the
+       same signal, so this split's own allpass state is the first stage's state.
+     - High's allpasses see LP + HP of this split. The low side's allpasses
+       already see LP, and High's first stages see HP, so by linearity the
+       state for LP + HP is the sum of the two.
+     */
+    static void getAllpassState(const float* s, float* ap)
+    {
+        static_assert(Low::NumCrossovers == 0, "the handover only knows how to split off the lowest band");
+        
+        ap[0] = s[0];
+        ap[1] = s[1];
+        
+        High::getAllpassState(s + HighOffset, ap + 2);
+        for( int k = 0; k < 2 * High::NumCrossovers; ++k )
+            ap[2 + k] += s[AllpassOffset + k];
+    }
+    
+    /*
+     the reverse can only be partial: the first stages get the allpass state
+     back, everything else starts from zero and needs time to settle.
+     */
+    static void setFromAllpassState(const float* ap, float* s)
+    {
+        static_assert(Low::NumCrossovers == 0, "the handover only knows how to split off the lowest band");
+        
+        std::fill(s, s + NumStates, 0.f);
+        s[0] = ap[0];
+        s[1] = ap[1];
+        
+        High::setFromAllpassState(ap + 2, s + HighOffset);
+    }
+    
+    template<typename Sink>
+    static JUCE_FORCEINLINE void process(float x, float* s, const LinkwitzRileyCoefficients* c, Sink& sink)
+    {
+        float yL, yB, yH, unused, low, high;
+        svfTick(x, s[0], s[1], c[C], yL, yB, yH);
+        svfTick(yL, s[2], s[3], c[C], low, unused, unused);
+        svfTick(yH, s[4], s[5], c[C], unused, unused, high);
+        
+        low = High::allpass(low, s + AllpassOffset, c);
+        
+        Low::process(low, s + LowOffset, c, sink);
+        High::process(high, s + HighOffset, c, sink);
+    }
+};
+
+//==============================================================================
+/*
+ the processor's bands, low to high:
+ 
+         Fc0          Fc1
+  in --> LP --> AP1 ---------------> band 0
+     \
+      -> HP --> LP ----------------> band 1
+            \
+             -> HP ----------------> band 2
+ 
+ Bands are handed to the sink in the order they appear here, so keep the
+ leaves numbered left to right.
+ */
+using Topology = Split<0,
+                       Band<0>,
+                       Split<1,
+                             Band<1>,
+                             Band<2>>>;
+
+static constexpr int NumBands = Topology::NumBands;
+static constexpr int NumCrossovers = Topology::NumCrossovers;
+static constexpr int NumStates = Topology::NumStates;
+static constexpr int NumAllpassStates = 2 * NumCrossovers;
+
+static_assert(NumCrossovers == NumBands - 1, "every crossover should add exactly one band");
+} //end namespace DspGraph
@@ -0,0 +1,136 @@
+/*
+  ==============================================================================
+
+    EngineBypass.h
+    Created: 19 Oct 2026 7:41:09pm
+    Author:  Marc Woodbury-Smith
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/*
+ Decides, block by block, whether the engine, the allpass that stands in for
+ it, or both have to run.
+ With every band bypassed and audible, the engine's output is the allpass
+ chain of the crossover, which is far cheaper to run.
+ - going into bypass is instant: the allpass takes its state from the
+   crossover, so its output carries on exactly where the engine's stopped.
+ - coming out, the crossover only gets part of its state back. It runs
+   unheard for a few time constants of the lowest crossover, then the output
+   fades from the allpass to the engine.
+ Asking for bypass again half way through fades straight back.
+ */
+struct EngineBypass
+{
+    static constexpr double FadeSeconds = 0.01;
+    static constexpr double WarmupTimeConstants = 5.0;
+    
+    struct Block
+    {
+        bool runEngine = true;
+        bool runAllpass = false;
+        
+        //copy the crossover state into the allpass, or back, before processing.
+        bool seedAllpass = false;
+        bool seedEngine = false;
+        
+        //the engine's share of the output at the start and end of the block.
+        float engineWeightStart = 1.f;
+        float engineWeightEnd = 1.f;
+        
+        bool isCrossfading() const { return runEngine && runAllpass; }
+    };
+    
+    void prepare(double newSampleRate)
+    {
+        sampleRate = newSampleRate;
+        fadeSamples = juce::jmax(1.0, FadeSeconds * sampleRate);
+        reset();
+    }
+    
+    /*
+     back to running the engine, e.g. after the state has been cleared.
+     */
+    void reset()
+    {
+        engineRunning = true;
+        allpassRunning = false;
+        engineWeight = 1.f;
+        warmupRemaining = 0;
+    }
+    
+    /*
+     call once per block.
+     'lowestCrossoverHz' sets how long the crossover needs to settle.
+     */
+    Block nextBlock(bool bypassRequested, int numSamples, float lowestCrossoverHz)
+    {
+        Block block;
+        auto step = static_cast<float>(numSamples / fadeSamples);
+        
+        if( bypassRequested )
+        {
+            if( ! allpassRunning )
+            {
+                block.seedAllpass = true;
+                allpassRunning = true;
+                engineWeight = 0.f;
+            }
+            
+            block.engineWeightStart = engineWeight;
+            engineWeight = juce::jmax(0.f, engineWeight - step);
+            block.engineWeightEnd = engineWeight;
+            
+            if( block.engineWeightStart == 0.f )
+                engineRunning = false;
+        }
+        else
+        {
+            if( ! engineRunning )
+            {
+                block.seedEngine = true;
+                engineRunning = true;
+                engineWeight = 0.f;
+                warmupRemaining = getWarmupSamples(lowestCrossoverHz);
+            }
+            
+            block.engineWeightStart = engineWeight;
+            if( warmupRemaining > 0 )
+                warmupRemaining -= numSamples;
+            else
+                engineWeight = juce::jmin(1.f, engineWeight + step);
+            block.engineWeightEnd = engineWeight;
+            
+            if( block.engineWeightStart == 1.f )
+                allpassRunning = false;
+        }
+        
+        block.runEngine = engineRunning;
+        block.runAllpass = allpassRunning;
+        return block;
+    }
+private:
+    double sampleRate = 44100.0;
+    double fadeSamples = 441.0;
+    
+    bool engineRunning = true;
+    bool allpassRunning = false;
+    float engineWeight = 1.f;
+    int warmupRemaining = 0;
+    
+    /*
+     the slowest pole pair of a Butterworth section at fc decays with a time
+     constant of sqrt(2) / (2 pi fc).
+     */
+    int getWarmupSamples(float lowestCrossoverHz) const
+    {
+        if( lowestCrossoverHz <= 0.f )
+            return 0;
+        
+        auto timeConstant = juce::MathConstants<double>::sqrt2 / (juce::MathConstants<double>::twoPi * lowestCrossoverHz);
+        return static_cast<int>(std::ceil(WarmupTimeConstants * timeConstant * sampleRate));
+    }
+};
@@ -1,78 +1,184 @@
-/*
-  ==============================================================================
-
-    Fifo.h
-    Created: 21 May 2024 12:21:44pm
-    Author:  Marc Woodbury-Smith
-
-  ==============================================================================
-*/
-
-#pragma once
-#include <JuceHeader.h>
-
-#include <array>
-template<typename T>
-struct Fifo
-{
-    void prepare(int numChannels, int numSamples)
-    {
-        static_assert( std::is_same_v<T, juce::AudioBuffer<float>>,
-                      "prepare(numChannels, numSamples) should only be used when the Fifo is holding juce::AudioBuffer<float>");
-        for( auto& buffer : buffers)
-        {
-            buffer.setSize(numChannels,
-                           numSamples,
-                           false,   //clear everything?
-                           true,    //including the extra space?
-                           true);   //avoid reallocating if you can?
-            buffer.clear();
-        }
-    }
-    
-    void prepare(size_t numElements)
-    {
-        static_assert( std::is_same_v<T, std::vector<float>>,
-                      "prepare(numElements) should only be used when the Fifo is holding std::vector<float>");
-        for( auto& buffer : buffers )
-        {
-            buffer.clear();
-            buffer.resize(numElements, 0);
-        }
-    }
-    
-    bool push(const T& t)
-    {
-        auto write = fifo.write(1);
-        if( write.blockSize1 > 0 )
-        {
-            buffers[write.startIndex1] = t;
-            return true;
-        }
-        
-        return false;
-    }
-    
-    bool pull(T& t)
-    {
-        auto read = fifo.read(1);
-        if( read.blockSize1 > 0 )
-        {
-            t = buffers[read.startIndex1];
-            return true;
-        }
-        
-        return false;
-    }
-    
-    int getNumAvailableForReading() const
-    {
-        return fifo.getNumReady();
-    }
-private:
-    static constexpr int Capacity = 30;
-    std::array<T, Capacity> buffers;
-    juce::AbstractFifo fifo {Capacity};
-};
-
-
+/*
+  ==============================================================================
+
+    Fifo.h
+    Created: 21 May 2024 12:21:44pm
+    Author:  Marc Woodbury-Smith
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+#include <vector>
+/*
+ how often a ring's producer found it full, and how often its consumer came
+ looking while the producer was running and found nothing to read.
+ Each counter has a single writer, any thread can read them.
+ */
+struct FifoCounters
+{
+    void noteDropped()
+    {
+        dropped.store(dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+    
+    /*
+     consumer side, after every read attempt, with the producer's current
+     write position. A consumer drains until it finds nothing, so an empty
+     attempt right after a successful one is just the end of a pass.
+     Otherwise it only counts if the producer wrote something since the last
+     attempt but not enough to read: a stopped producer starves nobody.
+     */
+    void noteRead(bool found, juce::uint64 writePosition)
+    {
+        if( ! found && ! lastReadFound && writePosition != lastWritePosition )
+            starved.store(starved.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        
+        lastReadFound = found;
+        lastWritePosition = writePosition;
+    }
+    
+    juce::uint64 getNumDropped() const { return dropped.load(std::memory_order_relaxed); }
+    juce::uint64 getNumStarved() const { return starved.load(std::memory_order_relaxed); }
+    
+    juce::String toString() const
+    {
+        return "dropped " + juce::String((juce::int64)getNumDropped())
+             + ", starved " + juce::String((juce::int64)getNumStarved());
+    }
+private:
+    std::atomic<juce::uint64> dropped { 0 };
+    std::atomic<juce::uint64> starved { 0 };
+    bool lastReadFound = false;
+    juce::uint64 lastWritePosition = 0;
+};
+
+//==============================================================================
+/*
+ A ring of preallocated slots handed between one producer and one consumer.
+ Nothing is copied: the producer fills a slot in place and publishes it, and
+ the consumer borrows it and hands it back. push() and pull() swap instead of
+ assigning, so the storage of every slot keeps circulating and nothing
+ allocates once the slots have grown to size.
+ */
+template<typename T>
+struct Fifo
+{
+    static constexpr int DefaultCapacity = 30;
+    
+    explicit Fifo(int capacity = DefaultCapacity) { setCapacity(capacity); }
+    
+    /*
+     the number of slots that can be waiting at once. Neither side may be
+     using the fifo while it changes, and the slots have to be prepared again.
+     */
+    void setCapacity(int newCapacity)
+    {
+        jassert(newCapacity > 0);
+        
+        //AbstractFifo always keeps one slot empty.
+        buffers.resize(static_cast<size_t>(newCapacity) + 1);
+        fifo.setTotalSize(newCapacity + 1);
+    }
+    
+    int getCapacity() const { return fifo.getTotalSize() - 1; }
+    
+    /*
+     forgets every slot waiting to be read. Neither side may be using the fifo.
+     */
+    void reset() { fifo.reset(); }
+    
+    void prepare(int numChannels, int numSamples)
+    {
+        static_assert( std::is_same_v<T, juce::AudioBuffer<float>>,
+                      "prepare(numChannels, numSamples) should only be used when the Fifo is holding juce::AudioBuffer<float>");
+        for( auto& buffer : buffers)
+        {
+            buffer.setSize(numChannels,
+                           numSamples,
+                           false,   //clear everything?
+                           true,    //including the extra space?
+                           true);   //avoid reallocating if you can?
+            buffer.clear();
+        }
+    }
+    
+    void prepare(size_t numElements)
+    {
+        static_assert( std::is_same_v<T, std::vector<float>>,
+                      "prepare(numElements) should only be used when the Fifo is holding std::vector<float>");
+        for( auto& buffer : buffers )
+        {
+            buffer.clear();
+            buffer.resize(numElements, 0);
+        }
+    }
+    
+    //==============================================================================
+    /*
+     producer side: the next free slot, or nullptr if the fifo is full.
+     Fill it in place, then call finishedWrite().
+     */
+    T* getWriteSlot()
+    {
+        int start1, size1, start2, size2;
+        fifo.prepareToWrite(1, start1, size1, start2, size2);
+        return size1 > 0 ? &buffers[(size_t)start1] : nullptr;
+    }
+    
+    void finishedWrite() { fifo.finishedWrite(1); }
+    
+    /*
+     consumer side: the oldest published slot, or nullptr if there is none.
+     It belongs to the consumer until finishedRead().
+     */
+    T* getReadSlot()
+    {
+        int start1, size1, start2, size2;
+        fifo.prepareToRead(1, start1, size1, start2, size2);
+        return size1 > 0 ? &buffers[(size_t)start1] : nullptr;
+    }
+    
+    void finishedRead() { fifo.finishedRead(1); }
+    
+    //==============================================================================
+    /*
+     swaps 't' into the next free slot, 't' gets the slot's old storage back.
+     */
+    bool push(T& t)
+    {
+        if( auto* slot = getWriteSlot() )
+        {
+            std::swap(*slot, t);
+            finishedWrite();
+            return true;
+        }
+        
+        return false;
+    }
+    
+    /*
+     swaps the oldest slot into 't', the slot keeps the storage 't' had.
+     */
+    bool pull(T& t)
+    {
+        if( auto* slot = getReadSlot() )
+        {
+            std::swap(*slot, t);
+            finishedRead();
+            return true;
+        }
+        
+        return false;
+    }
+    
+    int getNumAvailableForReading() const
+    {
+        return fifo.getNumReady();
+    }
+private:
+    std::vector<T> buffers;
+    juce::AbstractFifo fifo { 2 };
+};
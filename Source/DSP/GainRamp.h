@@ -0,0 +1,88 @@
+/*
+  ==============================================================================
+
+    GainRamp.h
+    Created: 19 Oct 2026 4:21:09pm
+    Author:  Marc Woodbury-Smith
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/*
+ The same linear gain ramp as juce::dsp::Gain, but instead of processing a
+ buffer it hands out the per-sample gains for a block, so the gain can be
+ folded into another kernel's loop.
+ */
+struct GainRamp
+{
+    static size_t getStorageSize(const juce::dsp::ProcessSpec& spec)
+    {
+        return static_cast<size_t>(spec.maximumBlockSize);
+    }
+    
+    /*
+     'storage' must hold getStorageSize(spec) floats and outlive this object.
+     */
+    void prepare(const juce::dsp::ProcessSpec& spec, float* storage)
+    {
+        sampleRate = spec.sampleRate;
+        gains = storage;
+        maxNumSamples = static_cast<int>(spec.maximumBlockSize);
+        reset();
+    }
+    
+    void setRampDurationSeconds(double newDurationSeconds)
+    {
+        if( rampDurationSeconds != newDurationSeconds )
+        {
+            rampDurationSeconds = newDurationSeconds;
+            reset();
+        }
+    }
+    
+    void setGainDecibels(float newGainDecibels)
+    {
+        gain.setTargetValue(juce::Decibels::decibelsToGain(newGainDecibels));
+    }
+    
+    /*
+     jumps straight to the target gain.
+     */
+    void reset()
+    {
+        if( sampleRate > 0.0 )
+            gain.reset(sampleRate, rampDurationSeconds);
+    }
+    
+    /*
+     advances the ramp by numSamples. Returns the gain for each sample,
+     or nullptr if the gain is constant for the whole block, in which case
+     getTargetGain() applies.
+     */
+    const float* getNextBlock(int numSamples)
+    {
+        if( ! gain.isSmoothing() )
+            return nullptr;
+        
+        jassert(gains != nullptr && numSamples <= maxNumSamples);
+        numSamples = juce::jmin(numSamples, maxNumSamples);
+        
+        for( int i = 0; i < numSamples; ++i )
+            gains[i] = gain.getNextValue();
+        
+        return gains;
+    }
+    
+    float getTargetGain() const { return gain.getTargetValue(); }
+    bool isSmoothing() const { return gain.isSmoothing(); }
+private:
+    juce::SmoothedValue<float> gain;
+    float* gains = nullptr;
+    int maxNumSamples = 0;
+    
+    double sampleRate = 0.0;
+    double rampDurationSeconds = 0.0;
+};
@@ -0,0 +1,118 @@
+/*
+  ==============================================================================
+
+    HalfBandDecimator.h
+    Created: 19 Oct 2026 9:41:18pm
+    Author:  Marc Woodbury-Smith
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+#include <array>
+
+/*
+ Halves the sample rate of one signal with a linear-phase half-band FIR.
+ Every other tap of a half-band filter is zero and the rest are symmetric
+ around the centre, so an output sample costs NumSideTaps multiplies plus
+ one for the centre tap. Only every second output is computed.
+ The history is a doubled delay line living in memory the owner provides.
+ */
+struct HalfBandDecimator
+{
+    /*
+     at 96 kHz this passes up to ~20.6 kHz and rejects everything that would
+     alias below that by ~70 dB.
+     */
+    static constexpr int Order = 62;   //must be 2 mod 4 so the end taps aren't zero
+    static constexpr int NumTaps = Order + 1;
+    static constexpr int Centre = Order / 2;
+    static constexpr int NumSideTaps = (Centre + 1) / 2;
+    static constexpr float AttenuationDb = 70.f;
+
+    static constexpr size_t StateSize = 2 * NumTaps;
+
+    struct Coefficients
+    {
+        float centre = 0.5f;
+        std::array<float, NumSideTaps> side {};   //tap Centre +- (2j + 1)
+
+        /*
+         a Kaiser-windowed sinc at a quarter of the sample rate.
+         Allocates, so call it from prepareToPlay().
+         */
+        static Coefficients design()
+        {
+            using Design = juce::dsp::FilterDesign<float>;
+            using Window = juce::dsp::WindowingFunction<float>;
+
+            auto beta = 0.1102f * (AttenuationDb - 8.7f);
+            auto fir = Design::designFIRLowpassWindowMethod(0.25f, 1.0, static_cast<size_t>(Order), Window::kaiser, beta);
+
+            const auto* taps = fir->getRawCoefficients();
+
+            Coefficients c;
+            c.centre = taps[Centre];
+            for( int j = 0; j < NumSideTaps; ++j )
+                c.side[(size_t)j] = taps[Centre + 2 * j + 1];
+
+            return c;
+        }
+    };
+
+    void prepare(float* stateStorage)
+    {
+        delayLine = stateStorage;
+        reset();
+    }
+
+    void reset()
+    {
+        if( delayLine != nullptr )
+            std::fill(delayLine, delayLine + StateSize, 0.f);
+
+        position = 0;
+        outputDue = false;
+    }
+
+    /*
+     decimates 'data' in place and returns the number of samples left in it.
+     Odd block sizes are fine; the phase carries over to the next block.
+     */
+    int process(float* data, int numSamples, const Coefficients& c)
+    {
+        jassert(delayLine != nullptr);
+
+        int numOut = 0;
+        for( int i = 0; i < numSamples; ++i )
+        {
+            delayLine[position] = delayLine[position + NumTaps] = data[i];
+            position = position + 1 == NumTaps ? 0 : position + 1;
+
+            outputDue = ! outputDue;
+            if( outputDue )
+                continue;
+
+            //the last NumTaps inputs, oldest first.
+            const auto* w = delayLine + position;
+
+            auto y = c.centre * w[Centre];
+            for( int j = 0; j < NumSideTaps; ++j )
+            {
+                auto d = 2 * j + 1;
+                y += c.side[(size_t)j] * (w[Centre - d] + w[Centre + d]);
+            }
+
+            //never overtakes the input: numOut <= i / 2.
+            data[numOut++] = y;
+        }
+
+        return numOut;
+    }
+private:
+    float* delayLine = nullptr;
+    int position = 0;
+    bool outputDue = false;
+};
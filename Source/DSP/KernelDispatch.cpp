@@ -0,0 +1,159 @@
+/*
+  ==============================================================================
+
+    KernelDispatch.cpp
+    Created: 19 Oct 2026 7:55:40pm
+    Author:  Marc Woodbury-Smith
+
+  ==============================================================================
+*/
+
+#include "KernelDispatch.h"
+
+#if JUCE_INTEL && (JUCE_GCC || JUCE_CLANG)
+ #define SIMPLEMBCOMP_MULTI_ISA 1
+#else
+ #define SIMPLEMBCOMP_MULTI_ISA 0
+#endif
+
+/*
+ Defines a namespace of thin wrappers around the Kernels templates, all compiled
+ with 'Target'. The kernels are force-inlined, so each variant gets its own
+ copy of the loops, vectorised for that instruction set.
+ */
+#define SIMPLEMBCOMP_DEFINE_KERNEL_VARIANT(Name, Target)                                        \
+namespace Name                                                                                  \
+{                                                                                               \
+    template<int NumChannels>                                                                   \
+    Target void splitBands(const float* const* in, const float* ramp, float gain,               \
+                           float* const* const* bands, float* state,                            \
+                           const Kernels::LinkwitzRileyCoefficients* crossovers,                \
+                           int numChannels, int numSamples)                                     \
+    {                                                                                           \
+        Kernels::splitBandsChannels<NumChannels>(in, ramp, gain, bands, state, crossovers,      \
+                                                 numChannels, numSamples);                      \
+    }                                                                                           \
+                                                                                                \
+    template<int NumChannels>                                                                   \
+    Target bool compress(float* const* data, float* envelopes,                                  \
+                         const Kernels::CompressorCoefficients& c,                              \
+                         int numChannels, int numSamples)                                       \
+    {                                                                                           \
+        return Kernels::compressChannels<NumChannels>(data, envelopes, c, numChannels,          \
+                                                      numSamples);                              \
+    }                                                                                           \
+                                                                                                \
+    template<int NumChannels>                                                                   \
+    Target void sumBands(float* const* output, const float* const* const* bands,                \
+                         const float* mask, int numBands, const float* ramp, float gain,        \
+                         int numChannels, int numSamples)                                       \
+    {                                                                                           \
+        Kernels::sumBands<NumChannels>(output, bands, mask, numBands, ramp, gain,               \
+                                       numChannels, numSamples);                                \
+    }                                                                                           \
+                                                                                                \
+    template<int NumChannels>                                                                   \
+    Target void processFused(float* const* io, const float* inputRamp, float inputGain,         \
+                             const float* outputRamp, float outputGain, float* crossoverState,  \
+                             const Kernels::LinkwitzRileyCoefficients* crossovers,              \
+                             const Kernels::FusedBand* bands, int numChannels, int numSamples)  \
+    {                                                                                           \
+        Kernels::processFusedChannels<NumChannels>(io, inputRamp, inputGain, outputRamp,        \
+                                                   outputGain, crossoverState, crossovers,      \
+                                                   bands, numChannels, numSamples);             \
+    }                                                                                           \
+                                                                                                \
+    template<int NumChannels>                                                                   \
+    Target void allpass(const float* const* in, float* const* out, const float* inputRamp,      \
+                        float inputGain, const float* outputRamp, float outputGain,             \
+                        float* state, const Kernels::LinkwitzRileyCoefficients* crossovers,     \
+                        int numChannels, int numSamples)                                        \
+    {                                                                                           \
+        Kernels::allpassChannels<NumChannels>(in, out, inputRamp, inputGain, outputRamp,        \
+                                              outputGain, state, crossovers,                    \
+                                              numChannels, numSamples);                         \
+    }                                                                                           \
+                                                                                                \
+    Target void magnitudesToDecibels(float* data, int numBins, float divisor, float negInf)     \
+    {                                                                                           \
+        Kernels::magnitudesToDecibels(data, numBins, divisor, negInf);                          \
+    }                                                                                           \
+                                                                                                \
+    KernelDispatch::KernelSet make(KernelDispatch::Isa isa)                                     \
+    {                                                                                           \
+        KernelDispatch::KernelSet set;                                                          \
+        set.isa = isa;                                                                          \
+        set.splitBands = { &splitBands<0>, &splitBands<1>, &splitBands<2> };                    \
+        set.compress = { &compress<0>, &compress<1>, &compress<2> };                            \
+        set.sumBands = { &sumBands<0>, &sumBands<1>, &sumBands<2> };                            \
+        set.processFused = { &processFused<0>, &processFused<1>, &processFused<2> };            \
+        set.allpass = { &allpass<0>, &allpass<1>, &allpass<2> };                                \
+        set.magnitudesToDecibels = &magnitudesToDecibels;                                       \
+        return set;                                                                             \
+    }                                                                                           \
+}
+
+namespace
+{
+SIMPLEMBCOMP_DEFINE_KERNEL_VARIANT(BaselineKernels, )
+
+#if SIMPLEMBCOMP_MULTI_ISA
+SIMPLEMBCOMP_DEFINE_KERNEL_VARIANT(AVX2Kernels, __attribute__((target("avx2,fma"))))
+SIMPLEMBCOMP_DEFINE_KERNEL_VARIANT(AVX512Kernels, __attribute__((target("avx512f,avx512vl,avx512dq,avx512bw,avx2,fma"))))
+#endif
+
+struct Variants
+{
+    Variants()
+    {
+        available.push_back(BaselineKernels::make(KernelDispatch::Isa::Baseline));
+        
+       #if SIMPLEMBCOMP_MULTI_ISA
+        if( juce::SystemStats::hasAVX2() && juce::SystemStats::hasFMA3() )
+            available.push_back(AVX2Kernels::make(KernelDispatch::Isa::AVX2));
+        
+        if( juce::SystemStats::hasAVX512F() && juce::SystemStats::hasAVX512VL()
+           && juce::SystemStats::hasAVX512DQ() && juce::SystemStats::hasAVX512BW() )
+            available.push_back(AVX512Kernels::make(KernelDispatch::Isa::AVX512));
+       #endif
+    }
+    
+    //filled once in the constructor, so the addresses never change.
+    std::vector<KernelDispatch::KernelSet> available;
+};
+
+const Variants& getVariants()
+{
+    static const Variants variants;
+    return variants;
+}
+} //end anonymous namespace
+
+namespace KernelDispatch
+{
+const char* getIsaName(Isa isa)
+{
+    switch( isa )
+    {
+        case Isa::Baseline: return "baseline";
+        case Isa::AVX2: return "AVX2";
+        case Isa::AVX512: return "AVX-512";
+    }
+    return "";
+}
+
+const KernelSet& get()
+{
+    //the last one available is the widest.
+    static const KernelSet& best = getVariants().available.back();
+    return best;
+}
+
+std::vector<const KernelSet*> getAvailable()
+{
+    std::vector<const KernelSet*> sets;
+    for( const auto& set : getVariants().available )
+        sets.push_back(&set);
+    return sets;
+}
+} //end namespace KernelDispatch
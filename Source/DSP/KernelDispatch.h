@@ -0,0 +1,110 @@
+/*
+  ==============================================================================
+
+    KernelDispatch.h
+    Created: 19 Oct 2026 7:55:40pm
+    Author:  Marc Woodbury-Smith
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "Kernels.h"
+
+#include <array>
+#include <vector>
+
+/*
+ The hot kernels compiled once per instruction set, with the best one the CPU
+ supports picked the first time get() is called.
+ 
+ The baseline variant is whatever the build targets (SSE2 on x86-64, NEON on arm64).
+ The AVX2 and AVX-512 variants are only built for x86 with GCC or Clang.
+ */
+namespace KernelDispatch
+{
+enum class Isa
+{
+    Baseline,
+    AVX2,
+    AVX512
+};
+
+const char* getIsaName(Isa isa);
+
+struct KernelSet
+{
+    using SplitFn = void (*)(const float* const* in,
+                             const float* ramp,
+                             float gain,
+                             float* const* const* bands,
+                             float* state,
+                             const Kernels::LinkwitzRileyCoefficients* crossovers,
+                             int numChannels,
+                             int numSamples);
+    
+    //false if the block was below the threshold and left untouched.
+    using CompressFn = bool (*)(float* const* data,
+                                float* envelopes,
+                                const Kernels::CompressorCoefficients& c,
+                                int numChannels,
+                                int numSamples);
+    
+    using SumFn = void (*)(float* const* output,
+                           const float* const* const* bands,
+                           const float* mask,
+                           int numBands,
+                           const float* ramp,
+                           float gain,
+                           int numChannels,
+                           int numSamples);
+    
+    using FusedFn = void (*)(float* const* io,
+                             const float* inputRamp,
+                             float inputGain,
+                             const float* outputRamp,
+                             float outputGain,
+                             float* crossoverState,
+                             const Kernels::LinkwitzRileyCoefficients* crossovers,
+                             const Kernels::FusedBand* bands,
+                             int numChannels,
+                             int numSamples);
+    
+    using AllpassFn = void (*)(const float* const* in,
+                               float* const* out,
+                               const float* inputRamp,
+                               float inputGain,
+                               const float* outputRamp,
+                               float outputGain,
+                               float* state,
+                               const Kernels::LinkwitzRileyCoefficients* crossovers,
+                               int numChannels,
+                               int numSamples);
+    
+    using DecibelFn = void (*)(float* data, int numBins, float divisor, float negativeInfinity);
+    
+    /*
+     indexed by channel count: [0] handles any count, [1] mono, [2] stereo.
+     */
+    static constexpr int NumSpecialisations = 3;
+    
+    Isa isa = Isa::Baseline;
+    std::array<SplitFn, NumSpecialisations> splitBands {};
+    std::array<CompressFn, NumSpecialisations> compress {};
+    std::array<SumFn, NumSpecialisations> sumBands {};
+    std::array<FusedFn, NumSpecialisations> processFused {};
+    std::array<AllpassFn, NumSpecialisations> allpass {};
+    DecibelFn magnitudesToDecibels = nullptr;
+};
+
+/*
+ the variant for this CPU. Thread-safe, and cheap after the first call.
+ */
+const KernelSet& get();
+
+/*
+ every variant this CPU can run, baseline first.
+ */
+std::vector<const KernelSet*> getAvailable();
+} //end namespace KernelDispatch
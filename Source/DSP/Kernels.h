@@ -0,0 +1,666 @@
+/*
+  ==============================================================================
+
+    Kernels.h
+    Created: 19 Oct 2026 4:21:09pm
+    Author:  Marc Woodbury-Smith
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "DspGraph.h"
+
+#include <array>
+#include <cstring>
+#include <limits>
+
+/*
+ Tight loops for the hot paths of processBlock().
+ They work on raw channel pointers and are written so the compiler can vectorise them.
+ 
+ Everything here is force-inlined so KernelDispatch can compile the same code
+ once per instruction set; call the loops through KernelDispatch::get().
+ */
+namespace Kernels
+{
+static constexpr int MaxBands = 8;
+static_assert(DspGraph::NumBands <= MaxBands, "raise MaxBands");
+
+//==============================================================================
+using DspGraph::LinkwitzRileyCoefficients;
+
+static constexpr int NumCrossoverStates = DspGraph::NumStates;
+
+/*
+ the sink that writes each band of the crossover into its own buffer.
+ */
+struct BandWriter
+{
+    float* const* const* bands;     //bands[b][ch]
+    int channel;
+    int sample;
+    
+    template<int B>
+    JUCE_FORCEINLINE void band(float x) { bands[B][channel][sample] = x; }
+};
+
+/*
+ splits NumChannels channels into DspGraph::NumBands bands, applying the input
+ gain as samples are read. 'ramp' holds one gain per sample, or is nullptr when
+ 'gain' applies to the whole block.
+ The channel loop has a constant bound, so each channel's filter state stays
+ in registers and the independent recursions of the channels are interleaved
+ sample by sample instead of running one channel after the other.
+ 'state' holds NumCrossoverStates floats per channel, 'crossovers' one set of
+ coefficients per crossover.
+ */
+template<int NumChannels>
+JUCE_FORCEINLINE void splitBandsFixed(const float* const* in,
+                                      const float* ramp,
+                                      float gain,
+                                      float* const* const* bands,
+                                      float* state,
+                                      const LinkwitzRileyCoefficients* crossovers,
+                                      int numSamples)
+{
+    static_assert(NumChannels > 0, "use splitBandsChannels<0>() for a runtime channel count");
+    
+    float s[NumChannels][NumCrossoverStates];
+    for( int ch = 0; ch < NumChannels; ++ch )
+        std::copy(state + ch * NumCrossoverStates, state + (ch + 1) * NumCrossoverStates, s[ch]);
+    
+    for( int i = 0; i < numSamples; ++i )
+    {
+        auto g = ramp != nullptr ? ramp[i] : gain;
+        for( int ch = 0; ch < NumChannels; ++ch )
+        {
+            BandWriter writer { bands, ch, i };
+            DspGraph::Topology::process(in[ch][i] * g, s[ch], crossovers, writer);
+        }
+    }
+    
+    for( int ch = 0; ch < NumChannels; ++ch )
+    {
+        for( auto& v : s[ch] )
+            juce::dsp::util::snapToZero(v);
+        
+        std::copy(s[ch], s[ch] + NumCrossoverStates, state + ch * NumCrossoverStates);
+    }
+}
+
+/*
+ NumChannels > 0 uses splitBandsFixed(), 0 splits numChannels channels one at a time.
+ */
+template<int NumChannels>
+JUCE_FORCEINLINE void splitBandsChannels(const float* const* in,
+                                         const float* ramp,
+                                         float gain,
+                                         float* const* const* bands,
+                                         float* state,
+                                         const LinkwitzRileyCoefficients* crossovers,
+                                         int numChannels,
+                                         int numSamples)
+{
+    if constexpr ( NumChannels > 0 )
+    {
+        juce::ignoreUnused(numChannels);
+        splitBandsFixed<NumChannels>(in, ramp, gain, bands, state, crossovers, numSamples);
+    }
+    else
+    {
+        for( int ch = 0; ch < numChannels; ++ch )
+        {
+            float* const* channelBands[DspGraph::NumBands];
+            float* bandChannel[DspGraph::NumBands];
+            for( int b = 0; b < DspGraph::NumBands; ++b )
+            {
+                bandChannel[b] = bands[b][ch];
+                channelBands[b] = &bandChannel[b];
+            }
+            
+            splitBandsFixed<1>(in + ch, ramp, gain, channelBands,
+                               state + ch * NumCrossoverStates, crossovers, numSamples);
+        }
+    }
+}
+
+/*
+ what the crossover sums to when nothing is done to the bands: the allpass
+ chain of DspGraph::Topology, with the same gains on the way in and out.
+ 'state' holds DspGraph::NumAllpassStates floats per channel.
+ 'out' may be the same as 'in'.
+ */
+template<int NumChannels>
+JUCE_FORCEINLINE void allpassChannels(const float* const* in,
+                                      float* const* out,
+                                      const float* inputRamp,
+                                      float inputGain,
+                                      const float* outputRamp,
+                                      float outputGain,
+                                      float* state,
+                                      const LinkwitzRileyCoefficients* crossovers,
+                                      int numChannels,
+                                      int numSamples)
+{
+    constexpr int NumStates = DspGraph::NumAllpassStates;
+    const int channels = NumChannels > 0 ? NumChannels : numChannels;
+    
+    for( int ch = 0; ch < channels; ++ch )
+    {
+        float s[NumStates];
+        std::copy(state + ch * NumStates, state + (ch + 1) * NumStates, s);
+        
+        auto* src = in[ch];
+        auto* dst = out[ch];
+        for( int i = 0; i < numSamples; ++i )
+        {
+            auto y = DspGraph::Topology::allpass(src[i] * (inputRamp != nullptr ? inputRamp[i] : inputGain),
+                                                 s,
+                                                 crossovers);
+            dst[i] = y * (outputRamp != nullptr ? outputRamp[i] : outputGain);
+        }
+        
+        for( auto& v : s )
+            juce::dsp::util::snapToZero(v);
+        
+        std::copy(s, s + NumStates, state + ch * NumStates);
+    }
+}
+
+//==============================================================================
+/*
+ the peak detector and gain computer of juce::dsp::Compressor.
+ */
+struct CompressorCoefficients
+{
+    float threshold = 1.f, thresholdInverse = 1.f, ratioInverse = 1.f;
+    float cteAT = 0.f, cteRL = 0.f;
+    
+    /*
+     cteRL^k for k in [0, numReleasePowers), for advancing a releasing
+     envelope over a whole block at once. Optional.
+     */
+    const float* releasePowers = nullptr;
+    int numReleasePowers = 0;
+};
+
+/*
+ one step of the peak detector.
+ */
+JUCE_FORCEINLINE void detect(float level, float& envelope, const CompressorCoefficients& c)
+{
+    auto cte = level > envelope ? c.cteAT : c.cteRL;
+    envelope = level + cte * (envelope - level);
+}
+
+JUCE_FORCEINLINE float compressSample(float x, float& envelope, const CompressorCoefficients& c)
+{
+    detect(std::abs(x), envelope, c);
+    
+    auto gain = envelope < c.threshold ? 1.f : std::pow(envelope * c.thresholdInverse, c.ratioInverse - 1.f);
+    return gain * x;
+}
+
+JUCE_FORCEINLINE float getPeak(const float* data, int numSamples)
+{
+    auto range = juce::FloatVectorOperations::findMinAndMax(data, numSamples);
+    return juce::jmax(-range.getStart(), range.getEnd());
+}
+
+/*
+ the envelope only moves between its old value and the levels it sees,
+ so if neither reaches the threshold no sample can be compressed and
+ only the envelope needs advancing.
+ */
+JUCE_FORCEINLINE bool isBelowThreshold(float peak, float envelope, const CompressorCoefficients& c)
+{
+    return peak < c.threshold && envelope < c.threshold;
+}
+
+/*
+ the envelope can't fall below envelope * cteRL^n within the block. If no
+ sample gets that high, every sample takes the release branch and the
+ detector is a one-pole lowpass with a closed form:
+ env[n] = cteRL^n * env[0] + (1 - cteRL) * sum(cteRL^(n-1-i) * |x[i]|)
+ which has no dependency from one sample to the next.
+ */
+JUCE_FORCEINLINE bool isReleasing(float peak, float envelope, const CompressorCoefficients& c, int numSamples)
+{
+    return numSamples < c.numReleasePowers && peak <= c.releasePowers[numSamples] * envelope;
+}
+
+JUCE_FORCEINLINE void release(const float* data, float& envelope, const CompressorCoefficients& c, int numSamples)
+{
+    auto sum = 0.f;
+    for( int i = 0; i < numSamples; ++i )
+        sum += c.releasePowers[numSamples - 1 - i] * std::abs(data[i]);
+    
+    envelope = c.releasePowers[numSamples] * envelope + (1.f - c.cteRL) * sum;
+}
+
+/*
+ returns false if the block was below the threshold and left untouched.
+ */
+JUCE_FORCEINLINE bool compress(float* data, float& envelope, const CompressorCoefficients& c, int numSamples)
+{
+    auto peak = getPeak(data, numSamples);
+    if( isBelowThreshold(peak, envelope, c) )
+    {
+        if( isReleasing(peak, envelope, c, numSamples) )
+        {
+            release(data, envelope, c, numSamples);
+        }
+        else
+        {
+            auto env = envelope;
+            for( int i = 0; i < numSamples; ++i )
+                detect(std::abs(data[i]), env, c);
+            
+            envelope = env;
+        }
+        return false;
+    }
+    
+    auto env = envelope;
+    for( int i = 0; i < numSamples; ++i )
+        data[i] = compressSample(data[i], env, c);
+    
+    envelope = env;
+    return true;
+}
+
+/*
+ compress() for all NumChannels channels at once, each with its own envelope,
+ with the channels interleaved the same way as splitBandsFixed().
+ The block is only left untouched if every channel is below the threshold.
+ */
+template<int NumChannels>
+JUCE_FORCEINLINE bool compressFixed(float* const* data, float* envelopes, const CompressorCoefficients& c, int numSamples)
+{
+    static_assert(NumChannels > 0, "use compress() per channel for a runtime channel count");
+    
+    auto belowThreshold = true, releasing = true;
+    for( int ch = 0; ch < NumChannels; ++ch )
+    {
+        auto peak = getPeak(data[ch], numSamples);
+        belowThreshold = belowThreshold && isBelowThreshold(peak, envelopes[ch], c);
+        releasing = releasing && isReleasing(peak, envelopes[ch], c, numSamples);
+    }
+    
+    if( belowThreshold && releasing )
+    {
+        for( int ch = 0; ch < NumChannels; ++ch )
+            release(data[ch], envelopes[ch], c, numSamples);
+        
+        return false;
+    }
+    
+    float env[NumChannels];
+    std::copy(envelopes, envelopes + NumChannels, env);
+    
+    if( belowThreshold )
+    {
+        for( int i = 0; i < numSamples; ++i )
+        {
+            for( int ch = 0; ch < NumChannels; ++ch )
+                detect(std::abs(data[ch][i]), env[ch], c);
+        }
+    }
+    else
+    {
+        for( int i = 0; i < numSamples; ++i )
+        {
+            for( int ch = 0; ch < NumChannels; ++ch )
+                data[ch][i] = compressSample(data[ch][i], env[ch], c);
+        }
+    }
+    
+    std::copy(env, env + NumChannels, envelopes);
+    return ! belowThreshold;
+}
+
+/*
+ returns false if no channel was touched.
+ */
+template<int NumChannels>
+JUCE_FORCEINLINE bool compressChannels(float* const* data,
+                                       float* envelopes,
+                                       const CompressorCoefficients& c,
+                                       int numChannels,
+                                       int numSamples)
+{
+    if constexpr ( NumChannels > 0 )
+    {
+        juce::ignoreUnused(numChannels);
+        return compressFixed<NumChannels>(data, envelopes, c, numSamples);
+    }
+    else
+    {
+        auto touched = false;
+        for( int ch = 0; ch < numChannels; ++ch )
+            touched = compress(data[ch], envelopes[ch], c, numSamples) || touched;
+        
+        return touched;
+    }
+}
+
+//==============================================================================
+/*
+ one band of the fused engine: its compressor, its place in the sum, and
+ where to accumulate the sums of squares for its level meters.
+ Every pointer addresses one float per channel.
+ */
+struct FusedBand
+{
+    CompressorCoefficients coefficients;
+    float* envelopes = nullptr;
+    bool compress = true;           //false when the band is bypassed
+    float mask = 1.f;               //0 when the band isn't audible
+    float* inputSumSquares = nullptr;
+    float* outputSumSquares = nullptr;
+    
+    //optional: accumulate the band, times tapGain, before and after compression.
+    float* preTap = nullptr;
+    float* postTap = nullptr;
+    float tapGain = 0.f;
+};
+
+/*
+ the sink of the fused engine: compresses each band as it leaves the crossover,
+ feeds its meters and analysis taps and adds it to the output sample.
+ */
+template<int NumChannels>
+struct FusedMixer
+{
+    const FusedBand* bands;
+    float (&envelopes)[DspGraph::NumBands][NumChannels];
+    float (&inputSumSquares)[DspGraph::NumBands][NumChannels];
+    float (&outputSumSquares)[DspGraph::NumBands][NumChannels];
+    const float* gains;     //the mask, or the mask times a constant output gain
+    int channel;
+    int sample;
+    float sum = 0.f;
+    
+    template<int B>
+    JUCE_FORCEINLINE void band(float x)
+    {
+        const auto& b = bands[B];
+        inputSumSquares[B][channel] += x * x;
+        if( b.preTap != nullptr )
+            b.preTap[sample] += b.tapGain * x;
+        
+        if( b.compress )
+            x = compressSample(x, envelopes[B][channel], b.coefficients);
+        
+        outputSumSquares[B][channel] += x * x;
+        if( b.postTap != nullptr )
+            b.postTap[sample] += b.tapGain * x;
+        
+        sum += gains[B] * x;
+    }
+};
+
+/*
+ input gain, split, compress, masked sum and output gain in one pass over 'io',
+ carrying each sample frame through every stage before moving to the next.
+ 'bands' has one entry per DspGraph band. The arithmetic matches the
+ block-by-block kernels, apart from the rounding of their closed-form
+ envelope release, so the two engines can be swapped between blocks.
+ */
+template<int NumChannels>
+JUCE_FORCEINLINE void processFusedFixed(float* const* io,
+                                        const float* inputRamp,
+                                        float inputGain,
+                                        const float* outputRamp,
+                                        float outputGain,
+                                        float* crossoverState,
+                                        const LinkwitzRileyCoefficients* crossovers,
+                                        const FusedBand* bands,
+                                        int numSamples)
+{
+    static_assert(NumChannels > 0, "use processFusedChannels<0>() for a runtime channel count");
+    constexpr int NumBands = DspGraph::NumBands;
+    
+    float s[NumChannels][NumCrossoverStates];
+    float env[NumBands][NumChannels];
+    float inSq[NumBands][NumChannels] = {};
+    float outSq[NumBands][NumChannels] = {};
+    
+    //the sum with a constant output gain folds it into the mask, like sumBandsFixed().
+    float masks[NumBands], constantGains[NumBands];
+    
+    for( int ch = 0; ch < NumChannels; ++ch )
+        std::copy(crossoverState + ch * NumCrossoverStates, crossoverState + (ch + 1) * NumCrossoverStates, s[ch]);
+    
+    for( int b = 0; b < NumBands; ++b )
+    {
+        std::copy(bands[b].envelopes, bands[b].envelopes + NumChannels, env[b]);
+        masks[b] = bands[b].mask;
+        constantGains[b] = bands[b].mask * outputGain;
+    }
+    
+    for( int i = 0; i < numSamples; ++i )
+    {
+        auto gIn = inputRamp != nullptr ? inputRamp[i] : inputGain;
+        for( int ch = 0; ch < NumChannels; ++ch )
+        {
+            FusedMixer<NumChannels> mixer { bands, env, inSq, outSq,
+                                            outputRamp != nullptr ? masks : constantGains, ch, i };
+            DspGraph::Topology::process(io[ch][i] * gIn, s[ch], crossovers, mixer);
+            
+            io[ch][i] = outputRamp != nullptr ? mixer.sum * outputRamp[i] : mixer.sum;
+        }
+    }
+    
+    for( int ch = 0; ch < NumChannels; ++ch )
+    {
+        for( auto& v : s[ch] )
+            juce::dsp::util::snapToZero(v);
+        
+        std::copy(s[ch], s[ch] + NumCrossoverStates, crossoverState + ch * NumCrossoverStates);
+    }
+    
+    for( int b = 0; b < NumBands; ++b )
+    {
+        std::copy(env[b], env[b] + NumChannels, bands[b].envelopes);
+        for( int ch = 0; ch < NumChannels; ++ch )
+        {
+            bands[b].inputSumSquares[ch] += inSq[b][ch];
+            bands[b].outputSumSquares[ch] += outSq[b][ch];
+        }
+    }
+}
+
+template<int NumChannels>
+JUCE_FORCEINLINE void processFusedChannels(float* const* io,
+                                           const float* inputRamp,
+                                           float inputGain,
+                                           const float* outputRamp,
+                                           float outputGain,
+                                           float* crossoverState,
+                                           const LinkwitzRileyCoefficients* crossovers,
+                                           const FusedBand* bands,
+                                           int numChannels,
+                                           int numSamples)
+{
+    if constexpr ( NumChannels > 0 )
+    {
+        juce::ignoreUnused(numChannels);
+        processFusedFixed<NumChannels>(io, inputRamp, inputGain, outputRamp, outputGain,
+                                       crossoverState, crossovers, bands, numSamples);
+    }
+    else
+    {
+        //the channels don't interact, so any channel count is a series of mono passes.
+        for( int ch = 0; ch < numChannels; ++ch )
+        {
+            FusedBand channelBands[DspGraph::NumBands];
+            for( int b = 0; b < DspGraph::NumBands; ++b )
+            {
+                channelBands[b] = bands[b];
+                channelBands[b].envelopes += ch;
+                channelBands[b].inputSumSquares += ch;
+                channelBands[b].outputSumSquares += ch;
+            }
+            
+            processFusedFixed<1>(io + ch, inputRamp, inputGain, outputRamp, outputGain,
+                                 crossoverState + ch * NumCrossoverStates, crossovers, channelBands, numSamples);
+        }
+    }
+}
+
+//==============================================================================
+template<int NumBands>
+JUCE_FORCEINLINE void sumBandsFixed(float* out,
+                          const std::array<const float*, MaxBands>& bands,
+                          const std::array<float, MaxBands>& bandGains,
+                          const float* ramp,
+                          float gain,
+                          int numSamples)
+{
+    if( ramp != nullptr )
+    {
+        for( int i = 0; i < numSamples; ++i )
+        {
+            auto sum = 0.f;
+            for( int b = 0; b < NumBands; ++b )
+                sum += bandGains[b] * bands[b][i];
+            
+            out[i] = sum * ramp[i];
+        }
+    }
+    else
+    {
+        //a constant output gain can be folded into the band gains.
+        std::array<float, MaxBands> g;
+        for( int b = 0; b < NumBands; ++b )
+            g[b] = bandGains[b] * gain;
+        
+        for( int i = 0; i < numSamples; ++i )
+        {
+            auto sum = 0.f;
+            for( int b = 0; b < NumBands; ++b )
+                sum += g[b] * bands[b][i];
+            
+            out[i] = sum;
+        }
+    }
+}
+
+/*
+ output[ch][i] = gain(i) * sum over b of (mask[b] * bands[b][ch][i])
+ 
+ 'bands[b]' is the array of channel pointers for band b.
+ Bands whose mask is 0 are never read. 'ramp' holds one gain per sample,
+ or is nullptr when 'gain' applies to the whole block.
+ 'output' may not alias any of the bands.
+ 
+ NumChannels > 0 fixes the channel count at compile time and 'numChannels' is
+ ignored; 0 uses 'numChannels'.
+ */
+template<int NumChannels = 0>
+JUCE_FORCEINLINE void sumBands(float* const* output,
+                     const float* const* const* bands,
+                     const float* mask,
+                     int numBands,
+                     const float* ramp,
+                     float gain,
+                     int numChannels,
+                     int numSamples)
+{
+    jassert(numBands <= MaxBands);
+    jassert(NumChannels == 0 || numChannels >= NumChannels);
+    
+    const int channels = NumChannels > 0 ? NumChannels : numChannels;
+    for( int ch = 0; ch < channels; ++ch )
+    {
+        std::array<const float*, MaxBands> active;
+        std::array<float, MaxBands> activeGains;
+        int numActive = 0;
+        
+        for( int b = 0; b < juce::jmin(numBands, MaxBands); ++b )
+        {
+            if( mask[b] != 0.f )
+            {
+                active[(size_t)numActive] = bands[b][ch];
+                activeGains[(size_t)numActive] = mask[b];
+                ++numActive;
+            }
+        }
+        
+        auto* out = output[ch];
+        switch( numActive )
+        {
+            case 0: juce::FloatVectorOperations::clear(out, numSamples); break;
+            case 1: sumBandsFixed<1>(out, active, activeGains, ramp, gain, numSamples); break;
+            case 2: sumBandsFixed<2>(out, active, activeGains, ramp, gain, numSamples); break;
+            case 3: sumBandsFixed<3>(out, active, activeGains, ramp, gain, numSamples); break;
+            default:
+            {
+                //more bands than the unrolled versions cover; accumulate one band at a time.
+                sumBandsFixed<1>(out, active, activeGains, ramp, gain, numSamples);
+                for( int b = 1; b < numActive; ++b )
+                {
+                    for( int i = 0; i < numSamples; ++i )
+                        out[i] += activeGains[(size_t)b] * active[(size_t)b][i] * (ramp != nullptr ? ramp[i] : gain);
+                }
+                break;
+            }
+        }
+    }
+}
+
+//==============================================================================
+/*
+ turns FFT magnitudes into dB for the analyzer: each bin is divided by
+ 'divisor', non-finite bins become silence, and nothing goes below negativeInfinity.
+ 
+ std::log10 is a library call the compiler won't vectorise, so the log is
+ taken from the float's bits instead: x = 2^e * m with m in [sqrt(0.5), sqrt(2)),
+ and log2(m) is a short odd series in (m - 1) / (m + 1). That is within
+ 1e-4 dB of 20 * log10(x), far below what the display can show.
+ */
+JUCE_FORCEINLINE void magnitudesToDecibels(float* data, int numBins, float divisor, float negativeInfinity)
+{
+    static constexpr float DbPerOctave = 6.02059991f;     //20 * log10(2)
+    static constexpr juce::uint32 ExponentMask = 0x7f800000;
+    static constexpr juce::uint32 SqrtHalfBits = 0x3f3504f3;
+    
+    const auto scale = 1.f / divisor;
+    
+    //everything at or below this is negativeInfinity, and it keeps x a normal float.
+    const auto floorGain = juce::jmax(std::numeric_limits<float>::min(),
+                                      std::pow(10.f, 0.05f * negativeInfinity));
+    
+    for( int i = 0; i < numBins; ++i )
+    {
+        //non-finite bins are zeroed as bits, a float select here would stop the vectoriser.
+        juce::uint32 bits;
+        std::memcpy(&bits, data + i, sizeof(bits));
+        bits = (bits & ExponentMask) != ExponentMask ? bits : 0u;
+        
+        float v;
+        std::memcpy(&v, &bits, sizeof(v));
+        v *= scale;
+        
+        auto x = juce::jmax(v, floorGain);
+        
+        std::memcpy(&bits, &x, sizeof(bits));
+        auto e = static_cast<juce::int32>(bits - SqrtHalfBits) >> 23;
+        bits -= static_cast<juce::uint32>(e) << 23;
+        
+        float m;
+        std::memcpy(&m, &bits, sizeof(m));
+        
+        auto u = (m - 1.f) / (m + 1.f);
+        auto u2 = u * u;
+        auto log2x = static_cast<float>(e) + u * (2.88539098f + u2 * (0.961523464f + u2 * 0.597266226f));
+        
+        //the floor itself is silence, whatever the series makes of it.
+        auto db = juce::jmax(negativeInfinity, DbPerOctave * log2x);
+        data[i] = v > floorGain ? db : negativeInfinity;
+    }
+}
+} //end namespace Kernels
@@ -1,11 +1,11 @@
-/*
-  ==============================================================================
-
-    Params.cpp
-    Created: 13 May 2024 5:09:31pm
-    Author:  Marc Woodbury-Smith
-
-  ==============================================================================
-*/
-
-#include "Params.h"
+/*
+  ==============================================================================
+
+    Params.cpp
+    Created: 13 May 2024 5:09:31pm
+    Author:  Marc Woodbury-Smith
+
+  ==============================================================================
+*/
+
+#include "Params.h"
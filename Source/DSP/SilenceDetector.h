@@ -0,0 +1,88 @@
+/*
+  ==============================================================================
+
+    SilenceDetector.h
+    Created: 19 Oct 2026 3:04:26pm
+    Author:  Marc Woodbury-Smith
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/*
+ Decides when an instance can stop processing.
+ The instance goes to sleep once both its input and its output have stayed
+ below the floor for HoldSeconds. The output check covers the ringing of the
+ crossover filters and the release of the compressor envelopes.
+ It wakes as soon as any input sample rises above the floor.
+ */
+struct SilenceDetector
+{
+    static constexpr float FloorDb = -100.f;
+    static constexpr double HoldSeconds = 1.0;
+
+    void prepare(double sampleRate)
+    {
+        holdSamples = static_cast<juce::int64>(HoldSeconds * sampleRate);
+        floorGain = juce::Decibels::decibelsToGain(FloorDb);
+        quietSamples = 0;
+        inputWasQuiet = false;
+        sleeping.store(false);
+    }
+
+    /*
+     call at the top of processBlock(). Returns true if the block can be skipped.
+     */
+    bool canSkip(const juce::AudioBuffer<float>& input)
+    {
+        inputWasQuiet = isBelowFloor(input);
+
+        if( ! sleeping.load(std::memory_order_relaxed) )
+            return false;
+
+        if( inputWasQuiet )
+            return true;
+
+        sleeping.store(false);
+        quietSamples = 0;
+        return false;
+    }
+
+    /*
+     call after processing. Returns true when the instance has just gone to sleep.
+     */
+    bool shouldSleepAfter(const juce::AudioBuffer<float>& output)
+    {
+        if( inputWasQuiet && isBelowFloor(output) )
+            quietSamples += output.getNumSamples();
+        else
+            quietSamples = 0;
+
+        if( quietSamples < holdSamples )
+            return false;
+
+        sleeping.store(true);
+        return true;
+    }
+
+    bool isSleeping() const { return sleeping.load(std::memory_order_relaxed); }
+private:
+    juce::int64 holdSamples = 0;
+    juce::int64 quietSamples = 0;
+    float floorGain = 0.f;
+    bool inputWasQuiet = false;
+
+    std::atomic<bool> sleeping { false };
+
+    bool isBelowFloor(const juce::AudioBuffer<float>& buffer) const
+    {
+        for( int ch = 0; ch < buffer.getNumChannels(); ++ch )
+        {
+            if( buffer.getMagnitude(ch, 0, buffer.getNumSamples()) >= floorGain )
+                return false;
+        }
+        return true;
+    }
+};
@@ -0,0 +1,231 @@
+/*
+  ==============================================================================
+
+    StageProfiler.h
+    Created: 19 Oct 2026 11:02:47am
+    Author:  Marc Woodbury-Smith
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+#include <array>
+
+/*
+ Times each stage of processBlock() into a log2 histogram.
+ The audio thread is the only writer, so every counter is a plain relaxed
+ load/store pair. Any other thread can take a Snapshot at any time.
+ */
+struct StageProfiler
+{
+    enum Stage
+    {
+        SplitBands,     //includes the input gain
+        CompressLowBand,
+        CompressMidBand,
+        CompressHighBand,
+        Summation,      //includes the output gain
+        AnalysisTap,    //interleaving every lane into the analyzer's ring
+        FusedEngine,    //everything from input gain to output gain, for small blocks
+        BypassAllpass,  //stands in for the engine when every band is bypassed
+        NumStages
+    };
+
+    /*
+     bucket b counts stages that took [2^b, 2^(b+1)) nanoseconds.
+     */
+    static constexpr int NumBuckets = 28;
+
+    static const char* getStageName(int stage)
+    {
+        static const char* names[NumStages] =
+        {
+            "gain + split",
+            "compress low",
+            "compress mid",
+            "compress high",
+            "sum + out gain",
+            "analysis tap",
+            "fused engine",
+            "bypass allpass"
+        };
+        return juce::isPositiveAndBelow(stage, (int)NumStages) ? names[stage] : "";
+    }
+
+    //==============================================================================
+    struct Snapshot
+    {
+        struct StageStats
+        {
+            std::array<juce::uint64, NumBuckets> buckets {};
+            juce::uint64 count = 0;
+            juce::uint64 totalNs = 0;
+            juce::uint64 maxNs = 0;
+
+            double getMeanMicroseconds() const { return count > 0 ? totalNs / (1000.0 * count) : 0.0; }
+            double getMaxMicroseconds() const { return maxNs / 1000.0; }
+
+            /*
+             upper edge of the bucket that contains the given percentile.
+             */
+            double getPercentileMicroseconds(double percentile) const
+            {
+                auto target = static_cast<juce::uint64>(std::ceil(count * percentile / 100.0));
+                juce::uint64 seen = 0;
+                for( int b = 0; b < NumBuckets; ++b )
+                {
+                    seen += buckets[(size_t)b];
+                    if( seen >= target && seen > 0 )
+                        return (double)(juce::uint64(1) << (b + 1)) / 1000.0;
+                }
+                return 0.0;
+            }
+        };
+
+        std::array<StageStats, NumStages> stages;
+
+        Snapshot& operator+=(const Snapshot& other)
+        {
+            for( size_t s = 0; s < stages.size(); ++s )
+            {
+                auto& mine = stages[s];
+                const auto& theirs = other.stages[s];
+                for( size_t b = 0; b < mine.buckets.size(); ++b )
+                    mine.buckets[b] += theirs.buckets[b];
+
+                mine.count += theirs.count;
+                mine.totalNs += theirs.totalNs;
+                mine.maxNs = juce::jmax(mine.maxNs, theirs.maxNs);
+            }
+            return *this;
+        }
+
+        juce::String toString() const
+        {
+            juce::String str;
+            str << juce::String("stage").paddedRight(' ', 16)
+                << juce::String("calls").paddedLeft(' ', 10)
+                << juce::String("mean us").paddedLeft(' ', 10)
+                << juce::String("p99 us").paddedLeft(' ', 10)
+                << juce::String("max us").paddedLeft(' ', 10) << juce::newLine;
+
+            for( int s = 0; s < NumStages; ++s )
+            {
+                const auto& stats = stages[(size_t)s];
+                str << juce::String(getStageName(s)).paddedRight(' ', 16)
+                    << juce::String((juce::int64)stats.count).paddedLeft(' ', 10)
+                    << juce::String(stats.getMeanMicroseconds(), 2).paddedLeft(' ', 10)
+                    << juce::String(stats.getPercentileMicroseconds(99.0), 2).paddedLeft(' ', 10)
+                    << juce::String(stats.getMaxMicroseconds(), 2).paddedLeft(' ', 10) << juce::newLine;
+            }
+            return str;
+        }
+    };
+
+    //==============================================================================
+    struct ScopedStage
+    {
+        ScopedStage(StageProfiler& p, int s) :
+        profiler(p),
+        stage(s),
+        startTicks(p.isEnabled() ? juce::Time::getHighResolutionTicks() : 0)
+        { }
+
+        ~ScopedStage()
+        {
+            if( startTicks != 0 )
+                profiler.record(stage, juce::Time::getHighResolutionTicks() - startTicks);
+        }
+    private:
+        StageProfiler& profiler;
+        int stage;
+        juce::int64 startTicks;
+    };
+
+    //==============================================================================
+    void setEnabled(bool shouldBeEnabled) { enabled.store(shouldBeEnabled, std::memory_order_relaxed); }
+    bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+    /*
+     can be called from any thread. The audio thread clears the counters at
+     the start of its next block, so the writer never races with the reset.
+     */
+    void requestReset() { resetRequested.store(true); }
+
+    /*
+     audio thread only, once per block before any stage is recorded.
+     */
+    void beginBlock()
+    {
+        if( resetRequested.exchange(false) )
+        {
+            for( auto& stats : stages )
+            {
+                for( auto& bucket : stats.buckets )
+                    bucket.store(0, std::memory_order_relaxed);
+
+                stats.count.store(0, std::memory_order_relaxed);
+                stats.totalNs.store(0, std::memory_order_relaxed);
+                stats.maxNs.store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void record(int stage, juce::int64 elapsedTicks)
+    {
+        jassert(juce::isPositiveAndBelow(stage, (int)NumStages));
+
+        auto ns = static_cast<juce::uint64>(juce::jmax(juce::int64(0), elapsedTicks) * nanosecondsPerTick);
+        auto& stats = stages[(size_t)stage];
+
+        auto clampedNs = static_cast<juce::uint32>(juce::jmin(ns, (juce::uint64)0xffffffffu));
+        auto bucket = juce::jmin(NumBuckets - 1, clampedNs > 0 ? juce::findHighestSetBit(clampedNs) : 0);
+
+        auto bump = [](auto& counter, auto amount)
+        {
+            counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+        };
+
+        bump(stats.buckets[(size_t)bucket], juce::uint64(1));
+        bump(stats.count, juce::uint64(1));
+        bump(stats.totalNs, ns);
+
+        if( ns > stats.maxNs.load(std::memory_order_relaxed) )
+            stats.maxNs.store(ns, std::memory_order_relaxed);
+    }
+
+    Snapshot getSnapshot() const
+    {
+        Snapshot snapshot;
+        for( size_t s = 0; s < stages.size(); ++s )
+        {
+            const auto& stats = stages[s];
+            auto& copy = snapshot.stages[s];
+
+            for( size_t b = 0; b < stats.buckets.size(); ++b )
+                copy.buckets[b] = stats.buckets[b].load(std::memory_order_relaxed);
+
+            copy.count = stats.count.load(std::memory_order_relaxed);
+            copy.totalNs = stats.totalNs.load(std::memory_order_relaxed);
+            copy.maxNs = stats.maxNs.load(std::memory_order_relaxed);
+        }
+        return snapshot;
+    }
+private:
+    struct AtomicStageStats
+    {
+        std::array<std::atomic<juce::uint64>, NumBuckets> buckets {};
+        std::atomic<juce::uint64> count { 0 };
+        std::atomic<juce::uint64> totalNs { 0 };
+        std::atomic<juce::uint64> maxNs { 0 };
+    };
+
+    std::array<AtomicStageStats, NumStages> stages;
+
+    std::atomic<bool> enabled { true };
+    std::atomic<bool> resetRequested { false };
+
+    const double nanosecondsPerTick = 1.0e9 / static_cast<double>(juce::Time::getHighResolutionTicksPerSecond());
+};
@@ -0,0 +1,66 @@
+/*
+  ==============================================================================
+
+    TripleBuffer.h
+    Created: 19 Oct 2026 10:17:33pm
+    Author:  Marc Woodbury-Smith
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+#include <array>
+
+/*
+ Hands the latest value from one producer to one consumer without locking.
+ Unlike a Fifo nothing queues up: the producer publishes whenever it has a
+ new value, the consumer picks up whatever is newest when it looks, and
+ anything in between is overwritten. Neither side ever waits or copies,
+ each just owns one of the three buffers and swaps it for the middle one.
+ */
+template<typename T>
+struct TripleBuffer
+{
+    //==============================================================================
+    //producer side
+    T& getWriteBuffer() { return buffers[(size_t)writeIndex]; }
+    
+    /*
+     makes the write buffer the newest value and hands the producer a
+     different one to fill next.
+     */
+    void publish()
+    {
+        auto previous = middle.exchange(writeIndex | NewFlag, std::memory_order_acq_rel);
+        writeIndex = previous & IndexMask;
+    }
+    
+    //==============================================================================
+    //consumer side
+    /*
+     takes over the newest published value, if there is one.
+     Returns false if nothing was published since the last call.
+     */
+    bool update()
+    {
+        if( (middle.load(std::memory_order_relaxed) & NewFlag) == 0 )
+            return false;
+        
+        auto previous = middle.exchange(readIndex, std::memory_order_acq_rel);
+        readIndex = previous & IndexMask;
+        return true;
+    }
+    
+    const T& getReadBuffer() const { return buffers[(size_t)readIndex]; }
+private:
+    static constexpr int IndexMask = 3;
+    static constexpr int NewFlag = 4;
+    
+    std::array<T, 3> buffers;
+    
+    int writeIndex = 0;             //producer only
+    std::atomic<int> middle { 1 };
+    int readIndex = 2;              //consumer only
+};
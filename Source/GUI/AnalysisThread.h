@@ -0,0 +1,31 @@
+/*
+  ==============================================================================
+
+    AnalysisThread.h
+    Created: 19 Oct 2026 10:21:05pm
+    Author:  Marc Woodbury-Smith
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/*
+ One low-priority thread that runs the FFTs and builds the paths of every
+ analyzer in the process, so none of that happens on the message thread.
+ Hold it through a juce::SharedResourcePointer<AnalysisThread>; it starts
+ with the first analyzer and stops when the last one goes away.
+ */
+struct AnalysisThread : juce::TimeSliceThread
+{
+    AnalysisThread() : juce::TimeSliceThread("SimpleMBComp analysis")
+    {
+        startThread(juce::Thread::Priority::low);
+    }
+    
+    ~AnalysisThread() override
+    {
+        stopThread(1000);
+    }
+};
@@ -1,85 +1,182 @@
-/*
-  ==============================================================================
-
-    AnalyzerPathGenerator.h
-    Created: 21 May 2024 12:15:08pm
-    Author:  Marc Woodbury-Smith
-
-  ==============================================================================
-*/
-
-#pragma once
-#include <JuceHeader.h>
-#include "Utilities.h"
-
-
-template<typename PathType>
-struct AnalyzerPathGenerator
-{
-    /*
-     converts 'renderData[]' into a juce::Path
-     */
-    void generatePath(const std::vector<float>& renderData,
-                      juce::Rectangle<float> fftBounds,
-                      int fftSize,
-                      float binWidth,
-                      float negativeInfinity)
-    {
-        auto top = fftBounds.getY();
-//        auto bottom = fftBounds.getHeight();
-        auto bottom = fftBounds.getBottom();
-        auto width = fftBounds.getWidth();
-
-        int numBins = (int)fftSize / 2;
-
-        PathType p;
-        p.preallocateSpace(3 * (int)fftBounds.getWidth());
-
-        auto map = [bottom, top, negativeInfinity](float v)
-        {
-            return juce::jmap(v,
-                              negativeInfinity, MAX_DECIBELS,
-                              //float(bottom+10),
-                              bottom, top);
-        };
-
-        auto y = map(renderData[0]);
-
-//        jassert( !std::isnan(y) && !std::isinf(y) );
-        if( std::isnan(y) || std::isinf(y) )
-            y = bottom;
-        
-        p.startNewSubPath(0, y);
-
-        const int pathResolution = 2; //you can draw line-to's every 'pathResolution' pixels.
-
-        for( int binNum = 1; binNum < numBins; binNum += pathResolution )
-        {
-            y = map(renderData[binNum]);
-
-//            jassert( !std::isnan(y) && !std::isinf(y) );
-
-            if( !std::isnan(y) && !std::isinf(y) )
-            {
-                auto binFreq = binNum * binWidth;
-                auto normalizedBinX = juce::mapFromLog10(binFreq, MIN_FREQUENCY, MAX_FREQUENCY);
-                int binX = std::floor(normalizedBinX * width);
-                p.lineTo(binX, y);
-            }
-        }
-
-        pathFifo.push(p);
-    }
-
-    int getNumPathsAvailable() const
-    {
-        return pathFifo.getNumAvailableForReading();
-    }
-
-    bool getPath(PathType& path)
-    {
-        return pathFifo.pull(path);
-    }
-private:
-    Fifo<PathType> pathFifo;
-};
+/*
+  ==============================================================================
+
+    AnalyzerPathGenerator.h
+    Created: 21 May 2024 12:15:08pm
+    Author:  Marc Woodbury-Smith
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "Utilities.h"
+
+
+template<typename PathType>
+struct AnalyzerPathGenerator
+{
+    /*
+     how the bins that land in the same pixel column become one point:
+     the loudest of them, or the average of their power.
+     */
+    enum class ColumnReduction
+    {
+        Max,
+        PowerAverage
+    };
+    
+    /*
+     any thread, applied from the next path.
+     */
+    void setColumnReduction(ColumnReduction r) { columnReduction.store(r); }
+    
+    /*
+     converts 'renderData[]' into a juce::Path
+     */
+    void generatePath(const std::vector<float>& renderData,
+                      juce::Rectangle<float> fftBounds,
+                      int fftSize,
+                      float binWidth,
+                      float negativeInfinity)
+    {
+        auto top = fftBounds.getY();
+//        auto bottom = fftBounds.getHeight();
+        auto bottom = fftBounds.getBottom();
+        auto width = fftBounds.getWidth();
+
+        updateColumns(juce::roundToInt(width), fftSize, binWidth);
+
+        /*
+         built in place in the fifo's next slot, which keeps the memory of
+         whatever path was in it before.
+         */
+        auto* slot = pathFifo.getWriteSlot();
+        if( slot == nullptr )
+            return;
+        
+        auto& p = *slot;
+        p.clear();
+        p.preallocateSpace(3 * static_cast<int>(columns.size() + 1));
+
+        auto map = [bottom, top, negativeInfinity](float v)
+        {
+            return juce::jmap(v,
+                              negativeInfinity, MAX_DECIBELS,
+                              //float(bottom+10),
+                              bottom, top);
+        };
+
+        auto y = map(renderData[0]);
+
+//        jassert( !std::isnan(y) && !std::isinf(y) );
+        if( std::isnan(y) || std::isinf(y) )
+            y = bottom;
+        
+        p.startNewSubPath(0, y);
+
+        //one point per pixel column, however many bins land in it.
+        const auto reduction = columnReduction.load();
+        for( const auto& column : columns )
+        {
+            y = map(reduce(renderData.data() + column.firstBin, column.numBins, reduction));
+
+//            jassert( !std::isnan(y) && !std::isinf(y) );
+
+            if( !std::isnan(y) && !std::isinf(y) )
+            {
+                p.lineTo(column.x, y);
+            }
+        }
+
+        pathFifo.finishedWrite();
+    }
+
+    void setCapacity(int numPaths) { pathFifo.setCapacity(numPaths); }
+    
+    int getNumPathsAvailable() const
+    {
+        return pathFifo.getNumAvailableForReading();
+    }
+
+    /*
+     swaps the oldest path into 'path'. Its old contents go back into the fifo.
+     */
+    bool getPath(PathType& path)
+    {
+        return pathFifo.pull(path);
+    }
+private:
+    Fifo<PathType> pathFifo;
+    
+    std::atomic<ColumnReduction> columnReduction { ColumnReduction::Max };
+    
+    /*
+     the run of bins that land in one pixel column. Low down every bin gets
+     a column of its own, higher up hundreds of bins share one.
+     */
+    struct Column
+    {
+        float x;
+        int firstBin;
+        int numBins;
+    };
+    
+    std::vector<Column> columns;
+    
+    //what 'columns' was built for.
+    int mappedWidth = -1;
+    int mappedFFTSize = 0;
+    float mappedBinWidth = 0.f;
+    
+    /*
+     the log mapping only depends on the width, the FFT size and the bin
+     width, so it's only worked out again when one of those changes.
+     */
+    void updateColumns(int width, int fftSize, float binWidth)
+    {
+        if( width == mappedWidth && fftSize == mappedFFTSize && binWidth == mappedBinWidth )
+            return;
+        
+        mappedWidth = width;
+        mappedFFTSize = fftSize;
+        mappedBinWidth = binWidth;
+        
+        int numBins = (int)fftSize / 2;
+        
+        columns.clear();
+        columns.reserve(static_cast<size_t>(juce::jmin(numBins, width + 1)));
+        
+        for( int binNum = 1; binNum < numBins; ++binNum )
+        {
+            auto binFreq = binNum * binWidth;
+            auto normalizedBinX = juce::mapFromLog10(binFreq, MIN_FREQUENCY, MAX_FREQUENCY);
+            int binX = std::floor(normalizedBinX * width);
+            
+            //anything past the right edge would be clipped anyway.
+            if( binX > width )
+                break;
+            
+            if( ! columns.empty() && columns.back().x == static_cast<float>(binX) )
+                ++columns.back().numBins;
+            else
+                columns.push_back({ static_cast<float>(binX), binNum, 1 });
+        }
+    }
+    
+    static float reduce(const float* decibels, int numBins, ColumnReduction reduction)
+    {
+        if( numBins == 1 )
+            return decibels[0];
+        
+        if( reduction == ColumnReduction::Max )
+            return juce::FloatVectorOperations::findMaximum(decibels, numBins);
+        
+        //10^(dB/10), averaged, and back to dB.
+        auto sum = 0.f;
+        for( int i = 0; i < numBins; ++i )
+            sum += std::pow(10.f, 0.1f * decibels[i]);
+        
+        return 10.f * std::log10(sum / static_cast<float>(numBins));
+    }
+};
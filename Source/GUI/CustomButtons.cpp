@@ -1,30 +1,30 @@
-/*
-  ==============================================================================
-
-    CustomButtons.cpp
-    Created: 13 May 2024 3:27:14pm
-    Author:  Marc Woodbury-Smith
-
-  ==============================================================================
-*/
-
-#include "CustomButtons.h"
-
-void AnalyzerButton::resized() 
-{
-    auto bounds = getLocalBounds();
-    auto insetRect = bounds.reduced(4);
-    
-    randomPath.clear();
-    
-    juce::Random r;
-    
-    randomPath.startNewSubPath(insetRect.getX(),
-                               insetRect.getY() + insetRect.getHeight() * r.nextFloat());
-    
-    for( auto x = insetRect.getX() + 1; x < insetRect.getRight(); x += 2 )
-    {
-        randomPath.lineTo(x,
-                          insetRect.getY() + insetRect.getHeight() * r.nextFloat());
-    }
-}
+/*
+  ==============================================================================
+
+    CustomButtons.cpp
+    Created: 13 May 2024 3:27:14pm
+    Author:  Marc Woodbury-Smith
+
+  ==============================================================================
+*/
+
+#include "CustomButtons.h"
+
+void AnalyzerButton::resized() 
+{
+    auto bounds = getLocalBounds();
+    auto insetRect = bounds.reduced(4);
+    
+    randomPath.clear();
+    
+    juce::Random r;
+    
+    randomPath.startNewSubPath(insetRect.getX(),
+                               insetRect.getY() + insetRect.getHeight() * r.nextFloat());
+    
+    for( auto x = insetRect.getX() + 1; x < insetRect.getRight(); x += 2 )
+    {
+        randomPath.lineTo(x,
+                          insetRect.getY() + insetRect.getHeight() * r.nextFloat());
+    }
+}
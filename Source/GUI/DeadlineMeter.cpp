@@ -0,0 +1,62 @@
+/*
+  ==============================================================================
+
+    DeadlineMeter.cpp
+    Created: 19 Oct 2026 2:10:52pm
+    Author:  Marc Woodbury-Smith
+
+  ==============================================================================
+*/
+
+#include "DeadlineMeter.h"
+
+juce::Colour DeadlineMeter::getColourForUtilisation(float utilisation)
+{
+    using namespace juce;
+    if( utilisation > 0.8f )
+        return Colours::red;
+    if( utilisation > 0.5f )
+        return Colours::orange;
+    
+    return Colour(0u, 172u, 1u);
+}
+
+void DeadlineMeter::paint(juce::Graphics &g)
+{
+    using namespace juce;
+    auto bounds = getLocalBounds();
+    
+    auto barArea = bounds.removeFromBottom(4).toFloat();
+    g.setColour(Colours::darkgrey);
+    g.fillRect(barArea);
+    
+    auto mean = snapshot.recentMeanUtilisation;
+    auto max = snapshot.recentMaxUtilisation;
+    
+    g.setColour(getColourForUtilisation(max).withAlpha(0.5f));
+    g.fillRect(barArea.withWidth(barArea.getWidth() * jlimit(0.f, 1.f, max)));
+    
+    g.setColour(getColourForUtilisation(mean));
+    g.fillRect(barArea.withWidth(barArea.getWidth() * jlimit(0.f, 1.f, mean)));
+    
+    String str;
+    str << "DSP " << roundToInt(100.f * mean) << "% (max " << roundToInt(100.f * max) << "%)";
+    str << "  >80%: " << (int64)snapshot.numBlocksOver[DeadlineMonitor::Over80Percent];
+    str << "  >100%: " << (int64)snapshot.numBlocksOver[DeadlineMonitor::Over100Percent];
+    
+    g.setColour(snapshot.numBlocksOver[DeadlineMonitor::Over100Percent] > 0 ? Colours::red : Colours::lightgrey);
+    g.setFont(10);
+    g.drawFittedText(str, bounds, Justification::centredLeft, 1);
+}
+
+void DeadlineMeter::mouseUp(const juce::MouseEvent &e)
+{
+    if( onClick && getLocalBounds().contains(e.getPosition()) )
+        onClick();
+}
+
+void DeadlineMeter::update(const DeadlineMonitor::Snapshot &newSnapshot)
+{
+    snapshot = newSnapshot;
+    repaint();
+}
@@ -0,0 +1,32 @@
+/*
+  ==============================================================================
+
+    DeadlineMeter.h
+    Created: 19 Oct 2026 2:10:52pm
+    Author:  Marc Woodbury-Smith
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "../DSP/DeadlineMonitor.h"
+
+/*
+ shows how much of the real-time budget processBlock() is using,
+ and how many blocks came close to, or missed, their deadline.
+ Clicking it calls onClick.
+ */
+struct DeadlineMeter : juce::Component
+{
+    void paint(juce::Graphics& g) override;
+    void mouseUp(const juce::MouseEvent& e) override;
+    
+    void update(const DeadlineMonitor::Snapshot& newSnapshot);
+    
+    std::function<void()> onClick;
+private:
+    DeadlineMonitor::Snapshot snapshot;
+    
+    static juce::Colour getColourForUtilisation(float utilisation);
+};
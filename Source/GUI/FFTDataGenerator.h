@@ -1,105 +1,110 @@
-/*
-  ==============================================================================
-
-    FFTDataGenerator.h
-    Created: 21 May 2024 12:08:14pm
-    Author:  Marc Woodbury-Smith
-
-  ==============================================================================
-*/
-
-#pragma once
-#include <JuceHeader.h>
-
-#include "Utilities.h"
-#include "../DSP/Fifo.h"
-
-
-
-template<typename BlockType>
-struct FFTDataGenerator
-{
-    /**
-     produces the FFT data from an audio buffer.
-     */
-    void produceFFTDataForRendering(const juce::AudioBuffer<float>& audioData, const float negativeInfinity)
-    {
-        const auto fftSize = getFFTSize();
-        
-        fftData.assign(fftData.size(), 0);
-        auto* readIndex = audioData.getReadPointer(0);
-        std::copy(readIndex, readIndex + fftSize, fftData.begin());
-        
-        // first apply a windowing function to our data
-        window->multiplyWithWindowingTable (fftData.data(), fftSize);       // [1]
-        
-        // then render our FFT data..
-        forwardFFT->performFrequencyOnlyForwardTransform (fftData.data());  // [2]
-        
-        int numBins = (int)fftSize / 2;
-        
-        
-        
-        //normalize the fft values.
-        for( int i = 0; i < numBins; ++i )
-        {
-            auto v = fftData[i];
-//            fftData[i] /= (float) numBins;
-            if( !std::isinf(v) && !std::isnan(v) )
-            {
-                v /= float(numBins);
-            }
-            else
-            {
-                v = 0.f;
-            }
-            fftData[i] = v;
-        }
-        
-        
-        float max = negativeInfinity;
-        
-        //convert them to decibels
-        for( int i = 0; i < numBins; ++i )
-        {
-            //fftData[i] = juce::Decibels::gainToDecibels(fftData[i], negativeInfinity);
-            auto data = juce::Decibels::gainToDecibels(fftData[i], negativeInfinity);
-            fftData[i] = data;
-            max = juce::jmax(data, max);
-        }
-        
-        //jassertfalse;
-        
-        fftDataFifo.push(fftData);
-    }
-    
-    void changeOrder(FFTOrder newOrder)
-    {
-        //when you change order, recreate the window, forwardFFT, fifo, fftData
-        //also reset the fifoIndex
-        //things that need recreating should be created on the heap via std::make_unique<>
-        
-        order = newOrder;
-        auto fftSize = getFFTSize();
-        
-        forwardFFT = std::make_unique<juce::dsp::FFT>(order);
-        window = std::make_unique<juce::dsp::WindowingFunction<float>>(fftSize, juce::dsp::WindowingFunction<float>::blackmanHarris);
-        
-        fftData.clear();
-        fftData.resize(fftSize * 2, 0);
-
-        fftDataFifo.prepare(fftData.size());
-    }
-    //==============================================================================
-    int getFFTSize() const { return 1 << order; }
-    int getNumAvailableFFTDataBlocks() const { return fftDataFifo.getNumAvailableForReading(); }
-    //==============================================================================
-    bool getFFTData(BlockType& fftData) { return fftDataFifo.pull(fftData); }
-private:
-    FFTOrder order;
-    BlockType fftData;
-    std::unique_ptr<juce::dsp::FFT> forwardFFT;
-    std::unique_ptr<juce::dsp::WindowingFunction<float>> window;
-    
-    Fifo<BlockType> fftDataFifo;
-};
+/*
+  ==============================================================================
+
+    FFTDataGenerator.h
+    Created: 21 May 2024 12:08:14pm
+    Author:  Marc Woodbury-Smith
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+#include "Utilities.h"
+#include "SharedResources.h"
+#include "../DSP/Fifo.h"
+#include "../DSP/KernelDispatch.h"
+
+
+
+template<typename BlockType>
+struct FFTDataGenerator
+{
+    /**
+     produces the FFT data from an audio buffer.
+     */
+    void produceFFTDataForRendering(const juce::AudioBuffer<float>& audioData, const float negativeInfinity)
+    {
+        jassert(audioData.getNumSamples() >= getFFTSize());
+        produceFFTDataForRendering(audioData.getReadPointer(0), negativeInfinity);
+    }
+    
+    /**
+     produces the FFT data from the getFFTSize() samples starting at 'window'.
+     */
+    void produceFFTDataForRendering(const float* window, const float negativeInfinity)
+    {
+        /*
+         the FFT is done in place in the fifo's next slot. If the reader
+         hasn't made room, the frame would be dropped anyway, so skip the work.
+         */
+        auto* slot = fftDataFifo.getWriteSlot();
+        if( slot == nullptr )
+            return;
+        
+        auto& fftData = *slot;
+        const auto fftSize = getFFTSize();
+        jassert(fftData.size() == static_cast<size_t>(fftSize) * 2);
+        
+        std::copy(window, window + fftSize, fftData.begin());
+        std::fill(fftData.begin() + fftSize, fftData.end(), 0.f);
+        
+        // first apply a windowing function to our data
+        plan->window.multiplyWithWindowingTable (fftData.data(), fftSize);  // [1]
+        
+        // then render our FFT data..
+        plan->fft.performFrequencyOnlyForwardTransform (fftData.data());    // [2]
+        
+        int numBins = (int)fftSize / 2;
+        
+        //normalize the fft values and convert them to decibels.
+        KernelDispatch::get().magnitudesToDecibels(fftData.data(), numBins, float(numBins), negativeInfinity);
+        
+        //jassertfalse;
+        
+        fftDataFifo.finishedWrite();
+    }
+    
+    void changeOrder(FFTOrder newOrder)
+    {
+        //when you change order, fetch the window and forwardFFT for it, recreate the fifo, fftData
+        //the FFT and window are read-only, so every analyzer in the process shares one of each per order.
+        
+        order = newOrder;
+        auto fftSize = getFFTSize();
+        
+        plan = sharedResources->getFFTPlan(order);
+        
+        //frames of the old size can't be read as the new one.
+        fftDataFifo.reset();
+        fftDataFifo.prepare(static_cast<size_t>(fftSize) * 2);
+    }
+    
+    FFTOrder getOrder() const { return order; }
+    /*
+     how many FFT frames can wait for the path generator.
+     */
+    void setCapacity(int numFrames)
+    {
+        fftDataFifo.setCapacity(numFrames);
+        fftDataFifo.prepare(static_cast<size_t>(getFFTSize()) * 2);
+    }
+    
+    int getCapacity() const { return fftDataFifo.getCapacity(); }
+    //==============================================================================
+    int getFFTSize() const { return 1 << order; }
+    int getNumAvailableFFTDataBlocks() const { return fftDataFifo.getNumAvailableForReading(); }
+    //==============================================================================
+    /*
+     the oldest FFT frame, read in place until finishedReadingFFTData().
+     */
+    const BlockType* getNextFFTData() { return fftDataFifo.getReadSlot(); }
+    void finishedReadingFFTData() { fftDataFifo.finishedRead(); }
+private:
+    FFTOrder order = FFTOrder::order2048;
+    juce::SharedResourcePointer<SharedResources> sharedResources;
+    std::shared_ptr<const SharedResources::FFTPlan> plan;
+    
+    Fifo<BlockType> fftDataFifo;
+};
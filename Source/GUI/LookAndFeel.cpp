@@ -1,152 +1,152 @@
-/*
-  ==============================================================================
-
-    LookAndFeel.cpp
-    Created: 13 May 2024 3:08:57pm
-    Author:  Marc Woodbury-Smith
-
-  ==============================================================================
-*/
-
-#include "LookAndFeel.h"
-#include "RotarySliderWithLabels.h"
-#include "Utilities.h"
-#include "CustomButtons.h"
-
-
-
-void LookAndFeel::drawRotarySlider(juce::Graphics & g,
-                                   int x,
-                                   int y,
-                                   int width,
-                                   int height,
-                                   float sliderPosProportional,
-                                   float rotaryStartAngle,
-                                   float rotaryEndAngle,
-                                   juce::Slider & slider)
-{
-    using namespace juce;
-    
-    auto bounds = Rectangle<float>(x, y, width, height);
-    
-    auto enabled = slider.isEnabled();
-    
-//    g.setColour(enabled ? Colour(97u, 18u, 167u) : Colours::darkgrey );
-    g.setColour(enabled ? ColorScheme::getModuleBorderColor() : Colours::darkgrey );
-    g.fillEllipse(bounds);
-    
-//    g.setColour(enabled ? Colour(255u, 154u, 1u) : Colours::grey);
-    g.setColour(enabled ? ColorScheme::getSliderBorderColor() : Colours::darkgrey );
-    g.drawEllipse(bounds, 1.f);
-    
-    if( auto* rswl = dynamic_cast<RotarySliderWithLabels*>(&slider))
-    {
-        auto center = bounds.getCentre();
-        Path p;
-        
-        Rectangle<float> r;
-        r.setLeft(center.getX() - 2);
-        r.setRight(center.getX() + 2);
-        r.setTop(bounds.getY());
-        r.setBottom(center.getY() - rswl->getTextHeight() * 1.5);
-        
-        p.addRoundedRectangle(r, 2.f);
-        
-        jassert(rotaryStartAngle < rotaryEndAngle);
-        
-        auto sliderAngRad = jmap(sliderPosProportional, 0.f, 1.f, rotaryStartAngle, rotaryEndAngle);
-        
-        p.applyTransform(AffineTransform().rotated(sliderAngRad, center.getX(), center.getY()));
-        
-        g.fillPath(p);
-        
-        g.setFont(rswl->getTextHeight());
-        auto text = rswl->getDisplayString();
-        auto strWidth = g.getCurrentFont().getStringWidth(text);
-        
-        r.setSize(strWidth + 4, rswl->getTextHeight() + 2);
-        r.setCentre(bounds.getCentre());
-        
-        g.setColour(enabled ? Colours::black : Colours::darkgrey);
-        g.fillRect(r);
-        
-        g.setColour(enabled ? Colours::white : Colours::lightgrey);
-        g.drawFittedText(text, r.toNearestInt(), juce::Justification::centred, 1);
-    }
-}
-
-void LookAndFeel::drawToggleButton(juce::Graphics &g,
-                                   juce::ToggleButton &toggleButton,
-                                   bool shouldDrawButtonAsHighlighted,
-                                   bool shouldDrawButtonAsDown)
-{
-    using namespace juce;
-    
-    if( auto* pb = dynamic_cast<PowerButton*>(&toggleButton) )
-    {
-        Path powerButton;
-        
-        auto bounds = toggleButton.getLocalBounds();
-        
-        auto size = jmin(bounds.getWidth(), bounds.getHeight()) - 6;
-        auto r = bounds.withSizeKeepingCentre(size, size).toFloat();
-        
-        float ang = 30.f; //30.f;
-        
-        size -= 6;
-        
-        powerButton.addCentredArc(r.getCentreX(),
-                                  r.getCentreY(),
-                                  size * 0.5,
-                                  size * 0.5,
-                                  0.f,
-                                  degreesToRadians(ang),
-                                  degreesToRadians(360.f - ang),
-                                  true);
-        
-        powerButton.startNewSubPath(r.getCentreX(), r.getY());
-        powerButton.lineTo(r.getCentre());
-        
-        PathStrokeType pst(2.f, PathStrokeType::JointStyle::curved);
-        
-        auto color = toggleButton.getToggleState() ? Colours::dimgrey : Colour(0u, 172u, 1u);
-        
-        g.setColour(color);
-        g.strokePath(powerButton, pst);
-        g.drawEllipse(r, 2);
-    }
-    else if( auto* analyzerButton = dynamic_cast<AnalyzerButton*>(&toggleButton) )
-    {
-        auto color = ! toggleButton.getToggleState() ? Colours::dimgrey : Colour(0u, 172u, 1u);
-        
-        g.setColour(color);
-        
-        auto bounds = toggleButton.getLocalBounds();
-        g.drawRect(bounds);
-        
-        g.strokePath(analyzerButton->randomPath, PathStrokeType(1.f));
-    }
-    else
-    {
-        auto bounds = toggleButton.getLocalBounds().reduced(2);
-                
-        auto buttonIsOn = toggleButton.getToggleState();
-        
-        const int cornerSize = 4;
-        
-        //g.setColour(buttonIsOn ? juce::Colours::white : juce::Colours::black);
-        g.setColour(buttonIsOn ?
-                            toggleButton.findColour(TextButton::ColourIds::buttonOnColourId) :
-                            toggleButton.findColour(TextButton::ColourIds::buttonColourId));
-        
-        
-        g.fillRoundedRectangle(bounds.toFloat(), cornerSize); //background
-        
-        g.setColour(buttonIsOn ? juce::Colours::black : juce::Colours::white);
-        g.drawRoundedRectangle(bounds.toFloat(), cornerSize, 1); //border
-        g.drawFittedText(toggleButton.getName(), bounds, juce::Justification::centred, 1); //text
-        
-
-    }
-    
-}
+/*
+  ==============================================================================
+
+    LookAndFeel.cpp
+    Created: 13 May 2024 3:08:57pm
+    Author:  Marc Woodbury-Smith
+
+  ==============================================================================
+*/
+
+#include "LookAndFeel.h"
+#include "RotarySliderWithLabels.h"
+#include "Utilities.h"
+#include "CustomButtons.h"
+
+
+
+void LookAndFeel::drawRotarySlider(juce::Graphics & g,
+                                   int x,
+                                   int y,
+                                   int width,
+                                   int height,
+                                   float sliderPosProportional,
+                                   float rotaryStartAngle,
+                                   float rotaryEndAngle,
+                                   juce::Slider & slider)
+{
+    using namespace juce;
+    
+    auto bounds = Rectangle<float>(x, y, width, height);
+    
+    auto enabled = slider.isEnabled();
+    
+//    g.setColour(enabled ? Colour(97u, 18u, 167u) : Colours::darkgrey );
+    g.setColour(enabled ? ColorScheme::getModuleBorderColor() : Colours::darkgrey );
+    g.fillEllipse(bounds);
+    
+//    g.setColour(enabled ? Colour(255u, 154u, 1u) : Colours::grey);
+    g.setColour(enabled ? ColorScheme::getSliderBorderColor() : Colours::darkgrey );
+    g.drawEllipse(bounds, 1.f);
+    
+    if( auto* rswl = dynamic_cast<RotarySliderWithLabels*>(&slider))
+    {
+        auto center = bounds.getCentre();
+        Path p;
+        
+        Rectangle<float> r;
+        r.setLeft(center.getX() - 2);
+        r.setRight(center.getX() + 2);
+        r.setTop(bounds.getY());
+        r.setBottom(center.getY() - rswl->getTextHeight() * 1.5);
+        
+        p.addRoundedRectangle(r, 2.f);
+        
+        jassert(rotaryStartAngle < rotaryEndAngle);
+        
+        auto sliderAngRad = jmap(sliderPosProportional, 0.f, 1.f, rotaryStartAngle, rotaryEndAngle);
+        
+        p.applyTransform(AffineTransform().rotated(sliderAngRad, center.getX(), center.getY()));
+        
+        g.fillPath(p);
+        
+        g.setFont(rswl->getTextHeight());
+        auto text = rswl->getDisplayString();
+        auto strWidth = g.getCurrentFont().getStringWidth(text);
+        
+        r.setSize(strWidth + 4, rswl->getTextHeight() + 2);
+        r.setCentre(bounds.getCentre());
+        
+        g.setColour(enabled ? Colours::black : Colours::darkgrey);
+        g.fillRect(r);
+        
+        g.setColour(enabled ? Colours::white : Colours::lightgrey);
+        g.drawFittedText(text, r.toNearestInt(), juce::Justification::centred, 1);
+    }
+}
+
+void LookAndFeel::drawToggleButton(juce::Graphics &g,
+                                   juce::ToggleButton &toggleButton,
+                                   bool shouldDrawButtonAsHighlighted,
+                                   bool shouldDrawButtonAsDown)
+{
+    using namespace juce;
+    
+    if( auto* pb = dynamic_cast<PowerButton*>(&toggleButton) )
+    {
+        Path powerButton;
+        
+        auto bounds = toggleButton.getLocalBounds();
+        
+        auto size = jmin(bounds.getWidth(), bounds.getHeight()) - 6;
+        auto r = bounds.withSizeKeepingCentre(size, size).toFloat();
+        
+        float ang = 30.f; //30.f;
+        
+        size -= 6;
+        
+        powerButton.addCentredArc(r.getCentreX(),
+                                  r.getCentreY(),
+                                  size * 0.5,
+                                  size * 0.5,
+                                  0.f,
+                                  degreesToRadians(ang),
+                                  degreesToRadians(360.f - ang),
+                                  true);
+        
+        powerButton.startNewSubPath(r.getCentreX(), r.getY());
+        powerButton.lineTo(r.getCentre());
+        
+        PathStrokeType pst(2.f, PathStrokeType::JointStyle::curved);
+        
+        auto color = toggleButton.getToggleState() ? Colours::dimgrey : Colour(0u, 172u, 1u);
+        
+        g.setColour(color);
+        g.strokePath(powerButton, pst);
+        g.drawEllipse(r, 2);
+    }
+    else if( auto* analyzerButton = dynamic_cast<AnalyzerButton*>(&toggleButton) )
+    {
+        auto color = ! toggleButton.getToggleState() ? Colours::dimgrey : Colour(0u, 172u, 1u);
+        
+        g.setColour(color);
+        
+        auto bounds = toggleButton.getLocalBounds();
+        g.drawRect(bounds);
+        
+        g.strokePath(analyzerButton->randomPath, PathStrokeType(1.f));
+    }
+    else
+    {
+        auto bounds = toggleButton.getLocalBounds().reduced(2);
+                
+        auto buttonIsOn = toggleButton.getToggleState();
+        
+        const int cornerSize = 4;
+        
+        //g.setColour(buttonIsOn ? juce::Colours::white : juce::Colours::black);
+        g.setColour(buttonIsOn ?
+                            toggleButton.findColour(TextButton::ColourIds::buttonOnColourId) :
+                            toggleButton.findColour(TextButton::ColourIds::buttonColourId));
+        
+        
+        g.fillRoundedRectangle(bounds.toFloat(), cornerSize); //background
+        
+        g.setColour(buttonIsOn ? juce::Colours::black : juce::Colours::white);
+        g.drawRoundedRectangle(bounds.toFloat(), cornerSize, 1); //border
+        g.drawFittedText(toggleButton.getName(), bounds, juce::Justification::centred, 1); //text
+        
+
+    }
+    
+}
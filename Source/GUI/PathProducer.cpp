@@ -1,67 +1,162 @@
-/*
-  ==============================================================================
-
-    PathProducer.cpp
-    Created: 21 May 2024 12:14:37pm
-    Author:  Marc Woodbury-Smith
-
-  ==============================================================================
-*/
-
-#include "PathProducer.h"
-
-void PathProducer::process(juce::Rectangle<float> fftBounds, double sampleRate)
-{
-    juce::AudioBuffer<float> tempIncomingBuffer;
-    while( leftChannelFifo->getNumCompleteBuffersAvailable() > 0 )
-    {
-        if( leftChannelFifo->getAudioBuffer(tempIncomingBuffer) )
-        {
-            auto size = tempIncomingBuffer.getNumSamples();
-            
-            jassert(size <= monoBuffer.getNumSamples());
-            size = juce::jmin(size, monoBuffer.getNumSamples());
-            
-            auto writePointer = monoBuffer.getWritePointer(0, 0);
-            auto readPointer = monoBuffer.getReadPointer(0, size);
-            
-            std::copy(readPointer,
-                      /*
-                       the 2nd parameter is the location of the last sample + 1 that we want to copy.
-                       */
-                      readPointer + (monoBuffer.getNumSamples() - size),
-                      /*
-                       the 3rd parameter is the destination buffer.
-                       */
-                      writePointer);
-
-//            juce::FloatVectorOperations::copy(monoBuffer.getWritePointer(0, 0),
-//                                              monoBuffer.getReadPointer(0, size),
-//                                              monoBuffer.getNumSamples() - size);
-
-            juce::FloatVectorOperations::copy(monoBuffer.getWritePointer(0, monoBuffer.getNumSamples() - size),
-                                              tempIncomingBuffer.getReadPointer(0, 0),
-                                              size);
-            
-            leftChannelFFTDataGenerator.produceFFTDataForRendering(monoBuffer, negativeInfinity);
-        }
-    }
-    
-    const auto fftSize = leftChannelFFTDataGenerator.getFFTSize();
-    const auto binWidth = sampleRate / double(fftSize);
-
-    while( leftChannelFFTDataGenerator.getNumAvailableFFTDataBlocks() > 0 )
-    {
-        std::vector<float> fftData;
-        if( leftChannelFFTDataGenerator.getFFTData( fftData) )
-        {
-            pathProducer.generatePath(fftData, fftBounds, fftSize, binWidth, negativeInfinity);
-        }
-    }
-    
-    while( pathProducer.getNumPathsAvailable() > 0 )
-    {
-        pathProducer.getPath( leftChannelFFTPath );
-    }
-}
-
+/*
+  ==============================================================================
+
+    PathProducer.cpp
+    Created: 21 May 2024 12:14:37pm
+    Author:  Marc Woodbury-Smith
+
+  ==============================================================================
+*/
+
+#include "PathProducer.h"
+
+int PathProducer::getHopSize(double sampleRate) const
+{
+    const auto fftSize = fftDataGenerator.getFFTSize();
+    
+    if( auto fps = framesPerSecond.load(); fps > 0.f && sampleRate > 0.0 )
+        return juce::jmax(1, juce::roundToInt(sampleRate / fps));
+    
+    return juce::jmax(1, juce::roundToInt(fftSize * (1.f - overlap.load())));
+}
+
+void PathProducer::updateCapacity(int hopSize)
+{
+    /*
+     enough FFT frames and paths to hold everything the tap can buffer,
+     at one FFT per hop.
+     */
+    auto numSamples = static_cast<juce::int64>(tap->getNumFrames()) * tap->getFrameSize();
+    auto capacity = static_cast<int>(numSamples / hopSize) + 1;
+    
+    if( capacity != fftDataGenerator.getCapacity() )
+    {
+        fftDataGenerator.setCapacity(capacity);
+        pathProducer.setCapacity(capacity);
+    }
+}
+
+void PathProducer::append(const float* frame, int numSamples)
+{
+    const auto fftSize = fftDataGenerator.getFFTSize();
+    
+    //the history only has room for one more window after moving back.
+    jassert(numSamples <= fftSize);
+    
+    if( writePosition + numSamples > monoBuffer.getNumSamples() )
+    {
+        //move the newest window back to the start of the history.
+        auto* history = monoBuffer.getWritePointer(0);
+        std::copy(history + writePosition - fftSize, history + writePosition, history);
+        writePosition = fftSize;
+    }
+    
+    //the lanes are read straight out of the tap's ring.
+    auto* dest = monoBuffer.getWritePointer(0, writePosition);
+    juce::FloatVectorOperations::clear(dest, numSamples);
+    
+    auto gain = 1.f / static_cast<float>(lanes.size());
+    for( auto lane : lanes )
+        AnalysisTap::addLane(frame, lane, gain, dest, numSamples);
+    
+    writePosition += numSamples;
+}
+
+void PathProducer::applyFFTOrder(FFTOrder newOrder)
+{
+    fftDataGenerator.changeOrder(newOrder);
+    
+    /*
+     twice the FFT size, so appending is a plain write and the history
+     only has to be moved back once every fftSize samples.
+     The old history is too short for the new window, so start from silence.
+     */
+    const auto fftSize = fftDataGenerator.getFFTSize();
+    monoBuffer.setSize(1, 2 * fftSize);
+    monoBuffer.clear();
+    writePosition = fftSize;
+    samplesUntilHop = 0;
+}
+
+void PathProducer::pushFrame(const float* frame)
+{
+    if( auto order = getFFTOrder(); order != fftDataGenerator.getOrder() )
+        applyFFTOrder(order);
+    
+    const auto fftSize = fftDataGenerator.getFFTSize();
+    const auto hopSize = getHopSize(tap->getSampleRate());
+    
+    updateCapacity(hopSize);
+    samplesUntilHop = samplesUntilHop > 0 ? juce::jmin(samplesUntilHop, hopSize) : hopSize;
+    
+    const auto size = tap->getFrameSize();
+    
+    if( latestFrameWins.load() )
+    {
+        //only the newest window is ever transformed, older samples can't reach it.
+        auto numSamples = juce::jmin(size, fftSize);
+        append(frame + static_cast<size_t>(size - numSamples) * AnalysisTap::NumLanes, numSamples);
+        hasNewSamples = true;
+        return;
+    }
+    
+    /*
+     append up to each hop boundary and transform only there, so the FFT
+     rate follows the hop size whatever the frame size is.
+     A frame may be longer than the FFT, and the hop too at low display
+     rates, so never append more than the history has room for at once.
+     */
+    for( int done = 0; done < size; )
+    {
+        auto numSamples = juce::jmin(size - done, samplesUntilHop, fftSize);
+        append(frame + static_cast<size_t>(done) * AnalysisTap::NumLanes, numSamples);
+        
+        done += numSamples;
+        samplesUntilHop -= numSamples;
+        
+        if( samplesUntilHop == 0 )
+        {
+            samplesUntilHop = hopSize;
+            fftDataGenerator.produceFFTDataForRendering(monoBuffer.getReadPointer(0, writePosition - fftSize),
+                                                        negativeInfinity.load());
+        }
+    }
+}
+
+void PathProducer::process(juce::Rectangle<float> fftBounds, double sampleRate)
+{
+    const auto fftSize = fftDataGenerator.getFFTSize();
+    const auto binWidth = sampleRate / double(fftSize);
+    const auto negInf = negativeInfinity.load();
+    
+    if( latestFrameWins.load() )
+    {
+        //anything still queued from before is older than the newest window.
+        while( fftDataGenerator.getNextFFTData() != nullptr )
+            fftDataGenerator.finishedReadingFFTData();
+        
+        if( ! hasNewSamples )
+            return;
+        
+        hasNewSamples = false;
+        fftDataGenerator.produceFFTDataForRendering(monoBuffer.getReadPointer(0, writePosition - fftSize), negInf);
+    }
+
+    while( auto* fftData = fftDataGenerator.getNextFFTData() )
+    {
+        pathProducer.generatePath(*fftData, fftBounds, fftSize, binWidth, negInf);
+        fftDataGenerator.finishedReadingFFTData();
+    }
+    
+    if( pathProducer.getNumPathsAvailable() == 0 )
+        return;
+    
+    //only the newest path is shown, the older ones just go back to the fifo.
+    auto& path = latestPath.getWriteBuffer();
+    while( pathProducer.getNumPathsAvailable() > 0 )
+    {
+        pathProducer.getPath( path );
+    }
+    
+    latestPath.publish();
+}
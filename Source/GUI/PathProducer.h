@@ -1,43 +1,125 @@
-/*
-  ==============================================================================
-
-    PathProducer.h
-    Created: 21 May 2024 12:14:37pm
-    Author:  Marc Woodbury-Smith
-
-  ==============================================================================
-*/
-
-#pragma once
-#include <JuceHeader.h>
-#include "FFTDataGenerator.h"
-#include "AnalyzerPathGenerator.h"
-#include "../PluginProcessor.h"
-
-
-
-struct PathProducer
-{
-    PathProducer(SingleChannelSampleFifo<SimpleMBCompAudioProcessor::BlockType>& scsf) :
-    leftChannelFifo(&scsf)
-    {
-        leftChannelFFTDataGenerator.changeOrder(FFTOrder::order2048);
-        monoBuffer.setSize(1, leftChannelFFTDataGenerator.getFFTSize());
-    }
-    void process(juce::Rectangle<float> fftBounds, double sampleRate);
-    juce::Path getPath() { return leftChannelFFTPath; }
-    
-    void updateNegativeInfinity(float nf) { negativeInfinity = nf; }
-private:
-    SingleChannelSampleFifo<SimpleMBCompAudioProcessor::BlockType>* leftChannelFifo;
-    
-    juce::AudioBuffer<float> monoBuffer;
-    
-    FFTDataGenerator<std::vector<float>> leftChannelFFTDataGenerator;
-    
-    AnalyzerPathGenerator<juce::Path> pathProducer;
-    
-    juce::Path leftChannelFFTPath;
-    
-    float negativeInfinity { -48.f };
-};
+/*
+  ==============================================================================
+
+    PathProducer.h
+    Created: 21 May 2024 12:14:37pm
+    Author:  Marc Woodbury-Smith
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "FFTDataGenerator.h"
+#include "AnalyzerPathGenerator.h"
+#include "../PluginProcessor.h"
+#include "../DSP/TripleBuffer.h"
+
+
+
+/*
+ turns one or more lanes of the processor's AnalysisTap into a spectrum path.
+ The lanes are averaged, e.g. OutputLeft and OutputRight for a mono sum.
+ pushFrame() and process() run on the AnalysisThread; the message thread
+ only ever calls getLatestPath() and updateNegativeInfinity().
+ */
+struct PathProducer
+{
+    PathProducer(AnalysisTap& analysisTap, std::vector<int> lanesToAverage) :
+    tap(&analysisTap),
+    lanes(std::move(lanesToAverage))
+    {
+        jassert( ! lanes.empty() );
+        applyFFTOrder(getFFTOrder());
+    }
+    
+    /*
+     appends one interleaved frame from the tap to the analysis history and
+     queues an FFT at every hop boundary that falls inside it.
+     */
+    void pushFrame(const float* frame);
+    
+    /*
+     how far the analysis window moves between FFTs, either as the overlap
+     of consecutive windows (0.75 = a quarter of the FFT size) or as a fixed
+     number of FFTs per second. Either way the FFT rate no longer depends on
+     the host's block size. Any thread; applied from the next hop.
+     */
+    static constexpr float DefaultOverlap = 0.75f;
+    
+    void setOverlap(float newOverlap)
+    {
+        overlap.store(juce::jlimit(0.f, 0.95f, newOverlap));
+        framesPerSecond.store(0.f);
+    }
+    
+    void setFramesPerSecond(float fps) { framesPerSecond.store(juce::jmax(0.f, fps)); }
+    
+    int getHopSize(double sampleRate) const;
+    
+    /*
+     any thread. The AnalysisThread builds the new plan and buffers itself,
+     between two frames, so the caller never waits for them and no frame
+     is ever transformed with a mix of the old and the new size.
+     */
+    void setFFTOrder(FFTOrder newOrder) { requestedOrder.store(newOrder); }
+    FFTOrder getFFTOrder() const { return static_cast<FFTOrder>(requestedOrder.load()); }
+    
+    /*
+     any thread. When the latest frame wins, frames are only appended to the
+     history and process() transforms just the newest window and builds one
+     path from it, so the work follows the display rate, not the audio rate.
+     Otherwise every hop gets its FFT and its path.
+     */
+    void setLatestFrameWins(bool shouldSkipStaleFrames) { latestFrameWins.store(shouldSkipStaleFrames); }
+    bool isLatestFrameWins() const { return latestFrameWins.load(); }
+    
+    using ColumnReduction = AnalyzerPathGenerator<juce::Path>::ColumnReduction;
+    
+    /*
+     any thread, see AnalyzerPathGenerator::ColumnReduction.
+     */
+    void setColumnReduction(ColumnReduction r) { pathProducer.setColumnReduction(r); }
+    
+    /*
+     turns the queued FFT frames into paths and publishes the newest one.
+     */
+    void process(juce::Rectangle<float> fftBounds, double sampleRate);
+    
+    /*
+     message thread: the newest path published by process().
+     */
+    const juce::Path& getLatestPath()
+    {
+        latestPath.update();
+        return latestPath.getReadBuffer();
+    }
+    
+    void updateNegativeInfinity(float nf) { negativeInfinity.store(nf); }
+private:
+    AnalysisTap* tap;
+    std::vector<int> lanes;
+    
+    juce::AudioBuffer<float> monoBuffer;
+    int writePosition = 0;      //the FFT window is the fftSize samples before this
+    int samplesUntilHop = 0;
+    
+    std::atomic<float> overlap { DefaultOverlap };
+    std::atomic<float> framesPerSecond { 0.f };    //0 means the overlap decides
+    std::atomic<int> requestedOrder { FFTOrder::order2048 };
+    std::atomic<bool> latestFrameWins { false };
+    bool hasNewSamples = false;     //since the newest window was last transformed
+    
+    void applyFFTOrder(FFTOrder newOrder);
+    
+    void append(const float* frame, int numSamples);
+    void updateCapacity(int hopSize);
+    
+    FFTDataGenerator<std::vector<float>> fftDataGenerator;
+    
+    AnalyzerPathGenerator<juce::Path> pathProducer;
+    
+    TripleBuffer<juce::Path> latestPath;
+    
+    std::atomic<float> negativeInfinity { -48.f };
+};
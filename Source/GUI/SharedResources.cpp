@@ -0,0 +1,50 @@
+/*
+  ==============================================================================
+
+    SharedResources.cpp
+    Created: 19 Oct 2026 6:40:12pm
+    Author:  Marc Woodbury-Smith
+
+  ==============================================================================
+*/
+
+#include "SharedResources.h"
+
+SharedResources::FFTPlan::FFTPlan(int o) :
+order(o),
+size(1 << o),
+fft(o),
+window(static_cast<size_t>(1 << o), juce::dsp::WindowingFunction<float>::blackmanHarris)
+{
+}
+
+std::shared_ptr<const SharedResources::FFTPlan> SharedResources::getFFTPlan(int order)
+{
+    return findOrCreate<FFTPlan>("fft " + juce::String(order),
+                                 [order]() { return std::make_shared<const FFTPlan>(order); });
+}
+
+std::shared_ptr<const juce::Image> SharedResources::getImage(const juce::String& name,
+                                                             int width,
+                                                             int height,
+                                                             float scale,
+                                                             const std::function<void(juce::Graphics&)>& draw)
+{
+    auto key = "image " + name
+             + " " + juce::String(width) + "x" + juce::String(height)
+             + "@" + juce::String(scale, 2);
+    
+    return findOrCreate<juce::Image>(key, [&]()
+    {
+        juce::Image image(juce::Image::ARGB,
+                          juce::jmax(1, juce::roundToInt(width * scale)),
+                          juce::jmax(1, juce::roundToInt(height * scale)),
+                          true);
+        {
+            juce::Graphics g(image);
+            g.addTransform(juce::AffineTransform::scale(scale));
+            draw(g);
+        }
+        return std::make_shared<const juce::Image>(image);
+    });
+}
@@ -0,0 +1,75 @@
+/*
+  ==============================================================================
+
+    SharedResources.h
+    Created: 19 Oct 2026 6:40:12pm
+    Author:  Marc Woodbury-Smith
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+#include <functional>
+#include <map>
+
+/*
+ Process-wide cache of read-only objects that every instance would otherwise
+ build its own copy of: FFT plans, window tables and rendered UI images.
+ Hold it through a juce::SharedResourcePointer<SharedResources>.
+ 
+ Entries are handed out as shared_ptrs to const and the cache only keeps weak
+ references, so an entry lives exactly as long as some instance is using it.
+ */
+struct SharedResources
+{
+    /*
+     an FFT and the Blackman-Harris window of the same size.
+     Both are only ever used through their const members, so any number of
+     analyzers can share one plan.
+     */
+    struct FFTPlan
+    {
+        explicit FFTPlan(int order);
+        
+        const int order;
+        const int size;
+        const juce::dsp::FFT fft;
+        const juce::dsp::WindowingFunction<float> window;
+    };
+    
+    std::shared_ptr<const FFTPlan> getFFTPlan(int order);
+    
+    /*
+     an image of width x height logical pixels at the given display scale,
+     drawn by 'draw' the first time that key is asked for.
+     'name' identifies what is drawn, so it must change if the drawing does.
+     */
+    std::shared_ptr<const juce::Image> getImage(const juce::String& name,
+                                                int width,
+                                                int height,
+                                                float scale,
+                                                const std::function<void(juce::Graphics&)>& draw);
+private:
+    template<typename T, typename Factory>
+    std::shared_ptr<const T> findOrCreate(const juce::String& key, Factory&& factory)
+    {
+        const juce::ScopedLock sl(lock);
+        
+        if( auto existing = entries[key].lock() )
+            return std::static_pointer_cast<const T>(existing);
+        
+        std::shared_ptr<const T> created = factory();
+        entries[key] = created;
+        
+        //drop the keys of anything nobody uses any more.
+        for( auto it = entries.begin(); it != entries.end(); )
+            it = it->second.expired() ? entries.erase(it) : std::next(it);
+        
+        return created;
+    }
+    
+    juce::CriticalSection lock;
+    std::map<juce::String, std::weak_ptr<const void>> entries;
+};
@@ -1,421 +1,548 @@
-/*
-  ==============================================================================
-
-    SpectrumAnalyzer.cpp
-    Created: 21 May 2024 12:14:23pm
-    Author:  Marc Woodbury-Smith
-
-  ==============================================================================
-*/
-
-#include "SpectrumAnalyzer.h"
-#include "Utilities.h"
-#include "../DSP/Params.h"
-
-SpectrumAnalyzer::SpectrumAnalyzer(SimpleMBCompAudioProcessor& p) :
-audioProcessor(p),
-leftPathProducer(audioProcessor.leftChannelFifo),
-rightPathProducer(audioProcessor.rightChannelFifo)
-{
-    const auto& params = audioProcessor.getParameters();
-    for( auto param : params )
-    {
-        param->addListener(this);
-    }
-
-//    updateChain();
-    
-    using namespace Params;
-    const auto& paramNames = GetParams();
-    
-    auto floatHelper = [&apvts = audioProcessor.apvts, &paramNames](auto& param, const auto& paramName)
-    {
-        param = dynamic_cast<juce::AudioParameterFloat*>(apvts.getParameter(paramNames.at(paramName)));
-        jassert( param != nullptr );
-    };
-    
-    floatHelper(lowMidXoverParam, Names::Low_Mid_Crossover_Freq);
-    floatHelper(midHighXoverParam, Names::Mid_High_Crossover_Freq);
-    
-    floatHelper(lowThresholdParam, Names::Threshold_Low_Band);
-    floatHelper(midThresholdParam, Names::Threshold_Mid_Band);
-    floatHelper(highThresholdParam, Names::Threshold_High_Band);
-
-    
-    
-    startTimerHz(60);
-}
-
-SpectrumAnalyzer::~SpectrumAnalyzer()
-{
-    const auto& params = audioProcessor.getParameters();
-    for( auto param : params )
-    {
-        param->removeListener(this);
-    }
-}
-
-void SpectrumAnalyzer::drawFFTAnalysis(juce::Graphics &g, juce::Rectangle<int> bounds)
-{
-    
-    using namespace juce;
-    auto responseArea = getAnalysisArea(bounds);
-    
-    juce::Graphics::ScopedSaveState sss(g);
-    g.reduceClipRegion(responseArea);
-    
-    auto leftChannelFFTPath = leftPathProducer.getPath();
-    leftChannelFFTPath.applyTransform(AffineTransform().translation(responseArea.getX(),
-                                                                    0//responseArea.getY()
-                                                                    ));
-    
-    g.setColour(Colour(97u, 18u, 167u)); //purple-
-    g.strokePath(leftChannelFFTPath, PathStrokeType(1.f));
-    
-    auto rightChannelFFTPath = rightPathProducer.getPath();
-    rightChannelFFTPath.applyTransform(AffineTransform().translation(responseArea.getX(), 0//responseArea.getY()
-                                                                     ));
-    
-    g.setColour(Colour(215u, 201u, 134u));
-    g.strokePath(rightChannelFFTPath, PathStrokeType(1.f));
-    
-}
-
-
-
-void SpectrumAnalyzer::paint (juce::Graphics& g)
-{
-    using namespace juce;
-    // (Our component is opaque, so we must completely fill the background with a solid colour)
-    g.fillAll (Colours::black);
-    
-    auto bounds = drawModuleBackground(g, getLocalBounds());
-
-    drawBackgroundGrid(g, bounds);
-    
-    //auto responseArea = getAnalysisArea(bounds);
-    
-    if( shouldShowFFTAnalysis )
-    {
-        drawFFTAnalysis(g, bounds);
-        
-    }
-    
-    drawCrossovers(g, bounds);
-    
-    
-//    g.setColour(Colours::white);
-//    g.strokePath(responseCurve, PathStrokeType(2.f));
-    
-//    Path border;
-//    
-//    border.setUsingNonZeroWinding(false);
-//    
-//    border.addRoundedRectangle(getRenderArea(bounds), 4);
-//    border.addRectangle(getLocalBounds());
-//    
-//    g.setColour(Colours::black);
-    
-//    g.fillPath(border);
-    
-    drawTextLabels(g, bounds);
-    
-//    g.setColour(Colours::orange);
-//    g.drawRoundedRectangle(getRenderArea(bounds).toFloat(), 4.f, 1.f);
-}
-
-void SpectrumAnalyzer::drawCrossovers(juce::Graphics &g, juce::Rectangle<int> bounds)
-{
-    using namespace juce;
-    bounds = getAnalysisArea(bounds);
-    
-    const auto top = bounds.getY();
-    const auto bottom = bounds.getBottom();
-    
-    auto left = bounds.getX();
-    auto right = bounds.getRight();
-    
-    auto mapX = [left = bounds.getX(), width = bounds.getWidth()](float frequency)
-    {
-        auto normX = juce::mapFromLog10(frequency, MIN_FREQUENCY, MAX_FREQUENCY);
-        return left + width * normX;
-    };
-    
-    auto lowMidX = mapX(lowMidXoverParam->get());
-    
-    g.setColour(Colours::orange);
-    g.drawVerticalLine(lowMidX, top, bottom);
-    
-    auto midHighX = mapX(midHighXoverParam->get());
-    g.drawVerticalLine(midHighX, top, bottom);
-    
-    auto mapY = [bottom, top](auto db)
-    {
-        return jmap(db, NEGATIVE_INFINITY, MAX_DECIBELS, float(bottom), float(top));
-    };
-    
-    auto zeroDb = mapY(0.f);
-    g.setColour(Colours::hotpink.withAlpha(0.3f));
-    
-    g.fillRect(Rectangle<float>::leftTopRightBottom(left, zeroDb, lowMidX, mapY(lowBandGR)));
-    g.fillRect(Rectangle<float>::leftTopRightBottom(lowMidX, zeroDb, midHighX, mapY(midBandGR)));
-    g.fillRect(Rectangle<float>::leftTopRightBottom(midHighX, zeroDb, right, mapY(highBandGR)));
-    
-    g.setColour(Colours::yellow);
-    g.drawHorizontalLine(mapY(lowThresholdParam->get()),
-                         left,
-                         lowMidX);
-    
-    g.drawHorizontalLine(mapY(midThresholdParam->get()),
-                         lowMidX,
-                         midHighX);
-    g.drawHorizontalLine(mapY(highThresholdParam->get()),
-                         midHighX,
-                         right);
-}
-
-
-void SpectrumAnalyzer::update(const std::vector<float>& values)
-{
-    jassert(values.size() == 6 );
-    
-    enum
-    {
-        LowBandIn,
-        LowBandOut,
-        MidBandIn,
-        MidBandOut,
-        HighBandIn,
-        HighBandOut
-    };
-    
-    lowBandGR = values[LowBandOut] - values[LowBandIn];
-    midBandGR = values[MidBandOut] - values[MidBandIn];
-    highBandGR = values[HighBandOut] - values[HighBandIn];
-    
-    repaint();
-}
-
-
-std::vector<float> SpectrumAnalyzer::getFrequencies()
-{
-    return std::vector<float>
-    {
-        20, /*30, 40,*/ 50, 100,
-        200, /*300, 400,*/ 500, 1000,
-        2000, /*3000, 4000,*/ 5000, 10000,
-        20000
-    };
-}
-
-std::vector<float> SpectrumAnalyzer::getGains()
-{
-//    return std::vector<float>
-//    {
-//        -24, -12, 0, 12, 24
-//    };
-    std::vector<float> values;
-    auto increment = MAX_DECIBELS; //12db steps
-    for( auto db = NEGATIVE_INFINITY; db <= MAX_DECIBELS; db += increment )
-    {
-        values.push_back(db);
-    }
-    
-    return values;
-}
-
-std::vector<float> SpectrumAnalyzer::getXs(const std::vector<float> &freqs, float left, float width)
-{
-    std::vector<float> xs;
-    for( auto f : freqs )
-    {
-        auto normX = juce::mapFromLog10(f, MIN_FREQUENCY, MAX_FREQUENCY);
-        xs.push_back( left + width * normX );
-    }
-    
-    return xs;
-}
-
-void SpectrumAnalyzer::drawBackgroundGrid(juce::Graphics &g, juce::Rectangle<int> bounds)
-{
-    using namespace juce;
-    auto freqs = getFrequencies();
-    
-    auto renderArea = getAnalysisArea(bounds);
-    auto left = renderArea.getX();
-    auto right = renderArea.getRight();
-    auto top = renderArea.getY();
-    auto bottom = renderArea.getBottom();
-    auto width = renderArea.getWidth();
-    
-    auto xs = getXs(freqs, left, width);
-    
-    g.setColour(Colours::dimgrey);
-    for( auto x : xs )
-    {
-        g.drawVerticalLine(x, top, bottom);
-    }
-    
-    auto gain = getGains();
-    
-    for( auto gDb : gain )
-    {
-//        auto y = jmap(gDb, -24.f, 24.f, float(bottom), float(top));
-        auto y = jmap(gDb, NEGATIVE_INFINITY, MAX_DECIBELS, float(bottom), float(top));
-        
-        g.setColour(gDb == 0.f ? Colour(0u, 172u, 1u) : Colours::darkgrey );
-        g.drawHorizontalLine(y, left, right);
-    }
-}
-
-void SpectrumAnalyzer::drawTextLabels(juce::Graphics &g, juce::Rectangle<int> bounds)
-{
-    using namespace juce;
-    g.setColour(Colours::lightgrey);
-    const int fontHeight = 10;
-    g.setFont(fontHeight);
-    
-    auto renderArea = getAnalysisArea(bounds);
-    auto left = renderArea.getX();
-    
-    auto top = renderArea.getY();
-    auto bottom = renderArea.getBottom();
-    auto width = renderArea.getWidth();
-    
-    auto freqs = getFrequencies();
-    auto xs = getXs(freqs, left, width);
-    
-    for( int i = 0; i < freqs.size(); ++i )
-    {
-        auto f = freqs[i];
-        auto x = xs[i];
-
-        bool addK = false;
-        String str;
-        if( f > 999.f )
-        {
-            addK = true;
-            f /= 1000.f;
-        }
-
-        str << f;
-        if( addK )
-            str << "k";
-        str << "Hz";
-        
-        auto textWidth = g.getCurrentFont().getStringWidth(str);
-
-        Rectangle<int> r;
-
-        r.setSize(textWidth, fontHeight);
-        r.setCentre(x, 0);
-//        r.setY(1);
-        r.setY(bounds.getY());
-        
-        g.drawFittedText(str, r, juce::Justification::centred, 1);
-    }
-    
-    auto gain = getGains();
-
-    for( auto gDb : gain )
-    {
-//        auto y = jmap(gDb, -24.f, 24.f, float(bottom), float(top));
-        auto y = jmap(gDb, NEGATIVE_INFINITY, MAX_DECIBELS, float(bottom), float(top));
-        
-        String str;
-        if( gDb > 0 )
-            str << "+";
-        str << gDb;
-        
-        auto textWidth = g.getCurrentFont().getStringWidth(str);
-        
-        Rectangle<int> r;
-        r.setSize(textWidth, fontHeight);
-//        r.setX(getWidth() - textWidth);
-        r.setX(bounds.getRight() - textWidth);
-        r.setCentre(r.getCentreX(), y);
-        
-        g.setColour(gDb == 0.f ? Colour(0u, 172u, 1u) : Colours::lightgrey );
-        
-        g.drawFittedText(str, r, juce::Justification::centredLeft, 1);
-        
-//        str.clear();
-//        str << (gDb - 24.f);
-
-//        r.setX(1);
-        r.setX(bounds.getX() + 1);
-//        textWidth = g.getCurrentFont().getStringWidth(str);
-//        r.setSize(textWidth, fontHeight);
-//        g.setColour(Colours::lightgrey);
-        g.drawFittedText(str, r, juce::Justification::centredLeft, 1);
-    }
-}
-
-void SpectrumAnalyzer::resized()
-{
-    using namespace juce;
-    
-    auto bounds = getLocalBounds();
-    auto fftBounds = getAnalysisArea(bounds).toFloat();
-    auto negInf = jmap(bounds.toFloat().getBottom(),
-                       fftBounds.getBottom(), fftBounds.getY(),
-                       NEGATIVE_INFINITY, MAX_DECIBELS);
-    
-    DBG( "negative infinity: " << negInf );
-        leftPathProducer.updateNegativeInfinity(negInf);
-        rightPathProducer.updateNegativeInfinity(negInf);
-//    responseCurve.preallocateSpace(getWidth() * 3);
-//    updateResponseCurve();
-}
-
-void SpectrumAnalyzer::parameterValueChanged(int parameterIndex, float newValue)
-{
-    parametersChanged.set(true);
-}
-
-
-void SpectrumAnalyzer::timerCallback()
-{
-    if( shouldShowFFTAnalysis )
-    {
-        auto bounds = getLocalBounds();
-        auto fftBounds = getAnalysisArea(bounds).toFloat();
-        fftBounds.setBottom(bounds.getBottom());
-        
-        auto sampleRate = audioProcessor.getSampleRate();
-        
-        leftPathProducer.process(fftBounds, sampleRate);
-        rightPathProducer.process(fftBounds, sampleRate);
-    }
-
-    if( parametersChanged.compareAndSetBool(false, true) )
-    {
-//        updateChain();
-//        updateResponseCurve();
-    }
-    
-    repaint();
-}
-
-
-
-juce::Rectangle<int> SpectrumAnalyzer::getRenderArea(juce::Rectangle<int> bounds)
-{
-//    auto bounds = getLocalBounds();
-    
-    bounds.removeFromTop(12);
-    bounds.removeFromBottom(2);
-    bounds.removeFromLeft(20);
-    bounds.removeFromRight(20);
-    
-    return bounds;
-}
-
-
-juce::Rectangle<int> SpectrumAnalyzer::getAnalysisArea(juce::Rectangle<int> bounds)
-{
-    bounds = getRenderArea(bounds);
-    bounds.removeFromTop(4);
-    bounds.removeFromBottom(4);
-    return bounds;
-}
+/*
+  ==============================================================================
+
+    SpectrumAnalyzer.cpp
+    Created: 21 May 2024 12:14:23pm
+    Author:  Marc Woodbury-Smith
+
+  ==============================================================================
+*/
+
+#include "SpectrumAnalyzer.h"
+#include "Utilities.h"
+#include "../DSP/Params.h"
+
+SpectrumAnalyzer::SpectrumAnalyzer(SimpleMBCompAudioProcessor& p) :
+audioProcessor(p),
+leftPathProducer(audioProcessor.analysisTap, { AnalysisTap::InputLeft }),
+rightPathProducer(audioProcessor.analysisTap, { AnalysisTap::InputRight }),
+outputPathProducer(audioProcessor.analysisTap, { AnalysisTap::OutputLeft, AnalysisTap::OutputRight })
+{
+    audioProcessor.analysisTap.setActive(shouldShowFFTAnalysis);
+    
+    const auto& params = audioProcessor.getParameters();
+    for( auto param : params )
+    {
+        param->addListener(this);
+    }
+
+//    updateChain();
+    
+    using namespace Params;
+    const auto& paramNames = GetParams();
+    
+    auto floatHelper = [&apvts = audioProcessor.apvts, &paramNames](auto& param, const auto& paramName)
+    {
+        param = dynamic_cast<juce::AudioParameterFloat*>(apvts.getParameter(paramNames.at(paramName)));
+        jassert( param != nullptr );
+    };
+    
+    floatHelper(lowMidXoverParam, Names::Low_Mid_Crossover_Freq);
+    floatHelper(midHighXoverParam, Names::Mid_High_Crossover_Freq);
+    
+    floatHelper(lowThresholdParam, Names::Threshold_Low_Band);
+    floatHelper(midThresholdParam, Names::Threshold_Mid_Band);
+    floatHelper(highThresholdParam, Names::Threshold_High_Band);
+
+    
+    
+    analysisThread->addTimeSliceClient(this);
+    startTimerHz(60);
+}
+
+SpectrumAnalyzer::~SpectrumAnalyzer()
+{
+    //waits for a slice that's already running.
+    analysisThread->removeTimeSliceClient(this);
+    audioProcessor.analysisTap.setActive(false);
+    
+    const auto& params = audioProcessor.getParameters();
+    for( auto param : params )
+    {
+        param->removeListener(this);
+    }
+}
+
+void SpectrumAnalyzer::drawFFTAnalysis(juce::Graphics &g, juce::Rectangle<int> bounds)
+{
+    
+    using namespace juce;
+    auto responseArea = getAnalysisArea(bounds);
+    
+    juce::Graphics::ScopedSaveState sss(g);
+    g.reduceClipRegion(responseArea);
+    
+    auto leftChannelFFTPath = leftPathProducer.getLatestPath();
+    leftChannelFFTPath.applyTransform(AffineTransform().translation(responseArea.getX(),
+                                                                    0//responseArea.getY()
+                                                                    ));
+    
+    g.setColour(Colour(97u, 18u, 167u)); //purple-
+    g.strokePath(leftChannelFFTPath, PathStrokeType(1.f));
+    
+    auto rightChannelFFTPath = rightPathProducer.getLatestPath();
+    rightChannelFFTPath.applyTransform(AffineTransform().translation(responseArea.getX(), 0//responseArea.getY()
+                                                                     ));
+    
+    g.setColour(Colour(215u, 201u, 134u));
+    g.strokePath(rightChannelFFTPath, PathStrokeType(1.f));
+    
+    auto outputFFTPath = outputPathProducer.getLatestPath();
+    outputFFTPath.applyTransform(AffineTransform().translation(responseArea.getX(), 0));
+    
+    g.setColour(Colours::lightblue);
+    g.strokePath(outputFFTPath, PathStrokeType(1.f));
+}
+
+
+
+void SpectrumAnalyzer::paint (juce::Graphics& g)
+{
+    using namespace juce;
+    // (Our component is opaque, so we must completely fill the background with a solid colour)
+    g.fillAll (Colours::black);
+    
+    updateCachedImages(g.getInternalContext().getPhysicalPixelScaleFactor());
+    
+    //same area drawModuleBackground() leaves for the contents.
+    auto bounds = getLocalBounds().reduced(3);
+    
+    g.drawImage(*backgroundImage, getLocalBounds().toFloat());
+    
+    //auto responseArea = getAnalysisArea(bounds);
+    
+    if( shouldShowFFTAnalysis.load() )
+    {
+        drawFFTAnalysis(g, bounds);
+        
+    }
+    
+    drawCrossovers(g, bounds);
+    
+    
+//    g.setColour(Colours::white);
+//    g.strokePath(responseCurve, PathStrokeType(2.f));
+    
+//    Path border;
+//    
+//    border.setUsingNonZeroWinding(false);
+//    
+//    border.addRoundedRectangle(getRenderArea(bounds), 4);
+//    border.addRectangle(getLocalBounds());
+//    
+//    g.setColour(Colours::black);
+    
+//    g.fillPath(border);
+    
+    g.drawImage(*labelsImage, getLocalBounds().toFloat());
+    
+//    g.setColour(Colours::orange);
+//    g.drawRoundedRectangle(getRenderArea(bounds).toFloat(), 4.f, 1.f);
+}
+
+void SpectrumAnalyzer::updateCachedImages(float scale)
+{
+    auto width = getWidth();
+    auto height = getHeight();
+    
+    auto isCurrent = [&](const auto& image)
+    {
+        return image != nullptr
+            && image->getWidth() == juce::jmax(1, juce::roundToInt(width * scale))
+            && image->getHeight() == juce::jmax(1, juce::roundToInt(height * scale));
+    };
+    
+    if( scale == cachedScale && isCurrent(backgroundImage) && isCurrent(labelsImage) )
+        return;
+    
+    cachedScale = scale;
+    
+    backgroundImage = sharedResources->getImage("analyzer background", width, height, scale, [this](juce::Graphics& g)
+    {
+        auto bounds = drawModuleBackground(g, getLocalBounds());
+        drawBackgroundGrid(g, bounds);
+    });
+    
+    labelsImage = sharedResources->getImage("analyzer labels", width, height, scale, [this](juce::Graphics& g)
+    {
+        drawTextLabels(g, getLocalBounds().reduced(3));
+    });
+}
+
+void SpectrumAnalyzer::drawCrossovers(juce::Graphics &g, juce::Rectangle<int> bounds)
+{
+    using namespace juce;
+    bounds = getAnalysisArea(bounds);
+    
+    const auto top = bounds.getY();
+    const auto bottom = bounds.getBottom();
+    
+    auto left = bounds.getX();
+    auto right = bounds.getRight();
+    
+    auto mapX = [left = bounds.getX(), width = bounds.getWidth()](float frequency)
+    {
+        auto normX = juce::mapFromLog10(frequency, MIN_FREQUENCY, MAX_FREQUENCY);
+        return left + width * normX;
+    };
+    
+    auto lowMidX = mapX(lowMidXoverParam->get());
+    
+    g.setColour(Colours::orange);
+    g.drawVerticalLine(lowMidX, top, bottom);
+    
+    auto midHighX = mapX(midHighXoverParam->get());
+    g.drawVerticalLine(midHighX, top, bottom);
+    
+    auto mapY = [bottom, top](auto db)
+    {
+        return jmap(db, NEGATIVE_INFINITY, MAX_DECIBELS, float(bottom), float(top));
+    };
+    
+    auto zeroDb = mapY(0.f);
+    g.setColour(Colours::hotpink.withAlpha(0.3f));
+    
+    g.fillRect(Rectangle<float>::leftTopRightBottom(left, zeroDb, lowMidX, mapY(lowBandGR)));
+    g.fillRect(Rectangle<float>::leftTopRightBottom(lowMidX, zeroDb, midHighX, mapY(midBandGR)));
+    g.fillRect(Rectangle<float>::leftTopRightBottom(midHighX, zeroDb, right, mapY(highBandGR)));
+    
+    g.setColour(Colours::yellow);
+    g.drawHorizontalLine(mapY(lowThresholdParam->get()),
+                         left,
+                         lowMidX);
+    
+    g.drawHorizontalLine(mapY(midThresholdParam->get()),
+                         lowMidX,
+                         midHighX);
+    g.drawHorizontalLine(mapY(highThresholdParam->get()),
+                         midHighX,
+                         right);
+}
+
+
+void SpectrumAnalyzer::update(const std::vector<float>& values)
+{
+    jassert(values.size() == 6 );
+    
+    enum
+    {
+        LowBandIn,
+        LowBandOut,
+        MidBandIn,
+        MidBandOut,
+        HighBandIn,
+        HighBandOut
+    };
+    
+    lowBandGR = values[LowBandOut] - values[LowBandIn];
+    midBandGR = values[MidBandOut] - values[MidBandIn];
+    highBandGR = values[HighBandOut] - values[HighBandIn];
+    
+    repaint();
+}
+
+
+std::vector<float> SpectrumAnalyzer::getFrequencies()
+{
+    return std::vector<float>
+    {
+        20, /*30, 40,*/ 50, 100,
+        200, /*300, 400,*/ 500, 1000,
+        2000, /*3000, 4000,*/ 5000, 10000,
+        20000
+    };
+}
+
+std::vector<float> SpectrumAnalyzer::getGains()
+{
+//    return std::vector<float>
+//    {
+//        -24, -12, 0, 12, 24
+//    };
+    std::vector<float> values;
+    auto increment = MAX_DECIBELS; //12db steps
+    for( auto db = NEGATIVE_INFINITY; db <= MAX_DECIBELS; db += increment )
+    {
+        values.push_back(db);
+    }
+    
+    return values;
+}
+
+std::vector<float> SpectrumAnalyzer::getXs(const std::vector<float> &freqs, float left, float width)
+{
+    std::vector<float> xs;
+    for( auto f : freqs )
+    {
+        auto normX = juce::mapFromLog10(f, MIN_FREQUENCY, MAX_FREQUENCY);
+        xs.push_back( left + width * normX );
+    }
+    
+    return xs;
+}
+
+void SpectrumAnalyzer::drawBackgroundGrid(juce::Graphics &g, juce::Rectangle<int> bounds)
+{
+    using namespace juce;
+    auto freqs = getFrequencies();
+    
+    auto renderArea = getAnalysisArea(bounds);
+    auto left = renderArea.getX();
+    auto right = renderArea.getRight();
+    auto top = renderArea.getY();
+    auto bottom = renderArea.getBottom();
+    auto width = renderArea.getWidth();
+    
+    auto xs = getXs(freqs, left, width);
+    
+    g.setColour(Colours::dimgrey);
+    for( auto x : xs )
+    {
+        g.drawVerticalLine(x, top, bottom);
+    }
+    
+    auto gain = getGains();
+    
+    for( auto gDb : gain )
+    {
+//        auto y = jmap(gDb, -24.f, 24.f, float(bottom), float(top));
+        auto y = jmap(gDb, NEGATIVE_INFINITY, MAX_DECIBELS, float(bottom), float(top));
+        
+        g.setColour(gDb == 0.f ? Colour(0u, 172u, 1u) : Colours::darkgrey );
+        g.drawHorizontalLine(y, left, right);
+    }
+}
+
+void SpectrumAnalyzer::drawTextLabels(juce::Graphics &g, juce::Rectangle<int> bounds)
+{
+    using namespace juce;
+    g.setColour(Colours::lightgrey);
+    const int fontHeight = 10;
+    g.setFont(fontHeight);
+    
+    auto renderArea = getAnalysisArea(bounds);
+    auto left = renderArea.getX();
+    
+    auto top = renderArea.getY();
+    auto bottom = renderArea.getBottom();
+    auto width = renderArea.getWidth();
+    
+    auto freqs = getFrequencies();
+    auto xs = getXs(freqs, left, width);
+    
+    for( int i = 0; i < freqs.size(); ++i )
+    {
+        auto f = freqs[i];
+        auto x = xs[i];
+
+        bool addK = false;
+        String str;
+        if( f > 999.f )
+        {
+            addK = true;
+            f /= 1000.f;
+        }
+
+        str << f;
+        if( addK )
+            str << "k";
+        str << "Hz";
+        
+        auto textWidth = g.getCurrentFont().getStringWidth(str);
+
+        Rectangle<int> r;
+
+        r.setSize(textWidth, fontHeight);
+        r.setCentre(x, 0);
+//        r.setY(1);
+        r.setY(bounds.getY());
+        
+        g.drawFittedText(str, r, juce::Justification::centred, 1);
+    }
+    
+    auto gain = getGains();
+
+    for( auto gDb : gain )
+    {
+//        auto y = jmap(gDb, -24.f, 24.f, float(bottom), float(top));
+        auto y = jmap(gDb, NEGATIVE_INFINITY, MAX_DECIBELS, float(bottom), float(top));
+        
+        String str;
+        if( gDb > 0 )
+            str << "+";
+        str << gDb;
+        
+        auto textWidth = g.getCurrentFont().getStringWidth(str);
+        
+        Rectangle<int> r;
+        r.setSize(textWidth, fontHeight);
+//        r.setX(getWidth() - textWidth);
+        r.setX(bounds.getRight() - textWidth);
+        r.setCentre(r.getCentreX(), y);
+        
+        g.setColour(gDb == 0.f ? Colour(0u, 172u, 1u) : Colours::lightgrey );
+        
+        g.drawFittedText(str, r, juce::Justification::centredLeft, 1);
+        
+//        str.clear();
+//        str << (gDb - 24.f);
+
+//        r.setX(1);
+        r.setX(bounds.getX() + 1);
+//        textWidth = g.getCurrentFont().getStringWidth(str);
+//        r.setSize(textWidth, fontHeight);
+//        g.setColour(Colours::lightgrey);
+        g.drawFittedText(str, r, juce::Justification::centredLeft, 1);
+    }
+}
+
+void SpectrumAnalyzer::resized()
+{
+    using namespace juce;
+    
+    auto bounds = getLocalBounds();
+    auto fftBounds = getAnalysisArea(bounds).toFloat();
+    auto negInf = jmap(bounds.toFloat().getBottom(),
+                       fftBounds.getBottom(), fftBounds.getY(),
+                       NEGATIVE_INFINITY, MAX_DECIBELS);
+    
+    DBG( "negative infinity: " << negInf );
+        leftPathProducer.updateNegativeInfinity(negInf);
+        rightPathProducer.updateNegativeInfinity(negInf);
+        outputPathProducer.updateNegativeInfinity(negInf);
+    
+    //the paths reach down to the bottom edge, below negative infinity.
+    fftBounds.setBottom(bounds.toFloat().getBottom());
+    
+    const juce::SpinLock::ScopedLockType sl(pathBoundsLock);
+    pathBounds = fftBounds;
+//    responseCurve.preallocateSpace(getWidth() * 3);
+//    updateResponseCurve();
+}
+
+void SpectrumAnalyzer::parameterValueChanged(int parameterIndex, float newValue)
+{
+    parametersChanged.set(true);
+}
+
+
+void SpectrumAnalyzer::setAnalysisOverlap(float overlap)
+{
+    leftPathProducer.setOverlap(overlap);
+    rightPathProducer.setOverlap(overlap);
+    outputPathProducer.setOverlap(overlap);
+}
+
+void SpectrumAnalyzer::setAnalysisFramesPerSecond(float fps)
+{
+    leftPathProducer.setFramesPerSecond(fps);
+    rightPathProducer.setFramesPerSecond(fps);
+    outputPathProducer.setFramesPerSecond(fps);
+}
+
+void SpectrumAnalyzer::setFFTOrder(FFTOrder order)
+{
+    leftPathProducer.setFFTOrder(order);
+    rightPathProducer.setFFTOrder(order);
+    outputPathProducer.setFFTOrder(order);
+}
+
+void SpectrumAnalyzer::setColumnReduction(PathProducer::ColumnReduction reduction)
+{
+    leftPathProducer.setColumnReduction(reduction);
+    rightPathProducer.setColumnReduction(reduction);
+    outputPathProducer.setColumnReduction(reduction);
+}
+
+void SpectrumAnalyzer::setLatestFrameWins(bool shouldSkipStaleFrames)
+{
+    leftPathProducer.setLatestFrameWins(shouldSkipStaleFrames);
+    rightPathProducer.setLatestFrameWins(shouldSkipStaleFrames);
+    outputPathProducer.setLatestFrameWins(shouldSkipStaleFrames);
+}
+
+void SpectrumAnalyzer::readTap()
+{
+    auto& tap = audioProcessor.analysisTap;
+    
+    //prepareToPlay() may be swapping the tap's storage on another thread.
+    const AnalysisTap::ScopedReader reader(tap);
+    if( ! reader.canRead() )
+        return;
+    
+    if( leftPathProducer.isLatestFrameWins() )
+    {
+        //only the frames inside the longest window can still show up.
+        auto windowSize = 1 << juce::jmax(leftPathProducer.getFFTOrder(),
+                                          rightPathProducer.getFFTOrder(),
+                                          outputPathProducer.getFFTOrder());
+        auto frameSize = juce::jmax(1, tap.getFrameSize());
+        tap.discardFrames(tap.getNumCompleteFramesAvailable() - (windowSize + frameSize - 1) / frameSize);
+    }
+    
+    //one pass over the tap feeds every path.
+    while( auto* frame = tap.getNextFrame() )
+    {
+        leftPathProducer.pushFrame(frame);
+        rightPathProducer.pushFrame(frame);
+        outputPathProducer.pushFrame(frame);
+        tap.finishedReading();
+    }
+}
+
+int SpectrumAnalyzer::useTimeSlice()
+{
+    const auto msPerRefresh = static_cast<int>(1000.0 / AnalysisTap::DisplayRateHz);
+    
+    if( ! shouldShowFFTAnalysis.load() )
+        return msPerRefresh;
+    
+    juce::Rectangle<float> bounds;
+    {
+        const juce::SpinLock::ScopedLockType sl(pathBoundsLock);
+        bounds = pathBounds;
+    }
+    
+    readTap();
+    
+    auto sampleRate = audioProcessor.analysisTap.getSampleRate();
+    leftPathProducer.process(bounds, sampleRate);
+    rightPathProducer.process(bounds, sampleRate);
+    outputPathProducer.process(bounds, sampleRate);
+    
+    return msPerRefresh;
+}
+
+void SpectrumAnalyzer::timerCallback()
+{
+    if( parametersChanged.compareAndSetBool(false, true) )
+    {
+//        updateChain();
+//        updateResponseCurve();
+    }
+    
+    repaint();
+}
+
+
+
+juce::Rectangle<int> SpectrumAnalyzer::getRenderArea(juce::Rectangle<int> bounds)
+{
+//    auto bounds = getLocalBounds();
+    
+    bounds.removeFromTop(12);
+    bounds.removeFromBottom(2);
+    bounds.removeFromLeft(20);
+    bounds.removeFromRight(20);
+    
+    return bounds;
+}
+
+
+juce::Rectangle<int> SpectrumAnalyzer::getAnalysisArea(juce::Rectangle<int> bounds)
+{
+    bounds = getRenderArea(bounds);
+    bounds.removeFromTop(4);
+    bounds.removeFromBottom(4);
+    return bounds;
+}
@@ -1,75 +1,127 @@
-/*
-  ==============================================================================
-
-    SpectrumAnalyzer.h
-    Created: 21 May 2024 12:14:23pm
-    Author:  Marc Woodbury-Smith
-
-  ==============================================================================
-*/
-
-#pragma once
-#include <JuceHeader.h>
-#include "PathProducer.h"
-
-
-struct SpectrumAnalyzer: juce::Component,
-juce::AudioProcessorParameter::Listener,
-juce::Timer
-{
-    SpectrumAnalyzer(SimpleMBCompAudioProcessor&);
-    ~SpectrumAnalyzer();
-    
-    void parameterValueChanged (int parameterIndex, float newValue) override;
-
-    void parameterGestureChanged (int parameterIndex, bool gestureIsStarting) override { }
-    
-    void timerCallback() override;
-    
-    void paint(juce::Graphics& g) override;
-    void resized() override;
-    
-    void toggleAnalysisEnablement(bool enabled)
-    {
-        shouldShowFFTAnalysis = enabled;
-    }
-    
-    void update(const std::vector<float>& values);
-private:
-    SimpleMBCompAudioProcessor& audioProcessor;
-
-    bool shouldShowFFTAnalysis = true;
-
-    juce::Atomic<bool> parametersChanged { false };
-    
-//    void drawBackgroundGrid(juce::Graphics& g);
-    void drawBackgroundGrid(juce::Graphics& g, juce::Rectangle<int> bounds);
-    
-    void drawTextLabels(juce::Graphics& g, juce::Rectangle<int> bounds);
-    
-    std::vector<float> getFrequencies();
-    std::vector<float> getGains();
-    std::vector<float> getXs(const std::vector<float>& freqs, float left, float width);
-
-    juce::Rectangle<int> getRenderArea(juce::Rectangle<int> bounds);
-    
-    juce::Rectangle<int> getAnalysisArea(juce::Rectangle<int> bounds);
-    
-    PathProducer leftPathProducer, rightPathProducer;
-    
-    void drawFFTAnalysis(juce::Graphics& g, juce::Rectangle<int> bounds);
-    
-    void drawCrossovers(juce::Graphics& g, juce::Rectangle<int> bounds);
-    
-    juce::AudioParameterFloat* lowMidXoverParam { nullptr };
-    juce::AudioParameterFloat* midHighXoverParam { nullptr };
-    
-    juce::AudioParameterFloat* lowThresholdParam { nullptr };
-    juce::AudioParameterFloat* midThresholdParam { nullptr };
-    juce::AudioParameterFloat* highThresholdParam { nullptr };
-    
-    float lowBandGR { 0.f }, midBandGR { 0.f }, highBandGR { 0.f };
-    
-};
- 
-
+/*
+  ==============================================================================
+
+    SpectrumAnalyzer.h
+    Created: 21 May 2024 12:14:23pm
+    Author:  Marc Woodbury-Smith
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "PathProducer.h"
+#include "SharedResources.h"
+#include "AnalysisThread.h"
+
+
+struct SpectrumAnalyzer: juce::Component,
+juce::AudioProcessorParameter::Listener,
+juce::Timer,
+juce::TimeSliceClient
+{
+    SpectrumAnalyzer(SimpleMBCompAudioProcessor&);
+    ~SpectrumAnalyzer();
+    
+    void parameterValueChanged (int parameterIndex, float newValue) override;
+
+    void parameterGestureChanged (int parameterIndex, bool gestureIsStarting) override { }
+    
+    void timerCallback() override;
+    
+    /*
+     AnalysisThread: drains the tap and turns it into paths.
+     */
+    int useTimeSlice() override;
+    
+    void paint(juce::Graphics& g) override;
+    void resized() override;
+    
+    void toggleAnalysisEnablement(bool enabled)
+    {
+        shouldShowFFTAnalysis.store(enabled);
+        audioProcessor.analysisTap.setActive(enabled);
+    }
+    
+    void update(const std::vector<float>& values);
+    
+    /*
+     see PathProducer::setOverlap() and setFramesPerSecond().
+     */
+    void setAnalysisOverlap(float overlap);
+    void setAnalysisFramesPerSecond(float fps);
+    
+    /*
+     the analyzer's resolution. Returns straight away; the AnalysisThread
+     switches over before its next frame.
+     */
+    void setFFTOrder(FFTOrder order);
+    
+    void setColumnReduction(PathProducer::ColumnReduction reduction);
+    
+    /*
+     see PathProducer::setLatestFrameWins(). The frames that can't reach
+     the newest window aren't even read from the tap.
+     */
+    void setLatestFrameWins(bool shouldSkipStaleFrames);
+private:
+    SimpleMBCompAudioProcessor& audioProcessor;
+
+    std::atomic<bool> shouldShowFFTAnalysis { true };
+
+    juce::Atomic<bool> parametersChanged { false };
+    
+//    void drawBackgroundGrid(juce::Graphics& g);
+    void drawBackgroundGrid(juce::Graphics& g, juce::Rectangle<int> bounds);
+    
+    void drawTextLabels(juce::Graphics& g, juce::Rectangle<int> bounds);
+    
+    std::vector<float> getFrequencies();
+    std::vector<float> getGains();
+    std::vector<float> getXs(const std::vector<float>& freqs, float left, float width);
+
+    juce::Rectangle<int> getRenderArea(juce::Rectangle<int> bounds);
+    
+    juce::Rectangle<int> getAnalysisArea(juce::Rectangle<int> bounds);
+    
+    PathProducer leftPathProducer, rightPathProducer, outputPathProducer;
+    
+    /*
+     AnalysisThread: feeds every frame waiting in the tap to the path producers.
+     */
+    void readTap();
+    
+    /*
+     where the paths are drawn, set by resized() and read by the AnalysisThread.
+     */
+    juce::SpinLock pathBoundsLock;
+    juce::Rectangle<float> pathBounds;
+    
+    juce::SharedResourcePointer<AnalysisThread> analysisThread;
+    
+    void drawFFTAnalysis(juce::Graphics& g, juce::Rectangle<int> bounds);
+    
+    void drawCrossovers(juce::Graphics& g, juce::Rectangle<int> bounds);
+    
+    juce::AudioParameterFloat* lowMidXoverParam { nullptr };
+    juce::AudioParameterFloat* midHighXoverParam { nullptr };
+    
+    juce::AudioParameterFloat* lowThresholdParam { nullptr };
+    juce::AudioParameterFloat* midThresholdParam { nullptr };
+    juce::AudioParameterFloat* highThresholdParam { nullptr };
+    
+    float lowBandGR { 0.f }, midBandGR { 0.f }, highBandGR { 0.f };
+    
+    /*
+     the background/grid and the text labels only depend on the size,
+     so they're rendered once and shared with every analyzer of the same size.
+     */
+    juce::SharedResourcePointer<SharedResources> sharedResources;
+    std::shared_ptr<const juce::Image> backgroundImage, labelsImage;
+    float cachedScale = 0.f;
+    
+    void updateCachedImages(float scale);
+    
+};
+ 
+
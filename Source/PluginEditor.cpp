@@ -1,163 +1,249 @@
-/*
-  ==============================================================================
-
-    This file contains the basic framework code for a JUCE plugin editor.
-
-  ==============================================================================
-*/
-
-#include "PluginProcessor.h"
-#include "PluginEditor.h"
-#include "DSP/Params.h"
-
-ControlBar::ControlBar()
-{
-    analyzerButton.setToggleState(true, juce::dontSendNotification);
-    addAndMakeVisible(analyzerButton);
-    addAndMakeVisible(globalBypassButton);
-}
-
-void ControlBar::resized()
-{
-    auto bounds = getLocalBounds();
-    analyzerButton.setBounds(bounds.removeFromLeft(50).withTrimmedTop(4).withTrimmedLeft(4));
-    
-    globalBypassButton.setBounds(bounds.removeFromRight(60).withTrimmedTop(2).withTrimmedBottom(2));
-}
-
-
-//==============================================================================
-SimpleMBCompAudioProcessorEditor::SimpleMBCompAudioProcessorEditor (SimpleMBCompAudioProcessor& p)
-    : AudioProcessorEditor (&p), audioProcessor (p)
-{
-    // Make sure that before the constructor has finished, you've set the
-    // editor's size to whatever you need it to be.
-    
-    controlBar.analyzerButton.onClick = [this]()
-    {
-        analyzer.toggleAnalysisEnablement(controlBar.analyzerButton.getToggleState());
-    };
-    
-    controlBar.globalBypassButton.onClick = [this]()
-    {
-        toggleGlobalBypassState();
-    };
-    
-    //addAndMakeVisible(controlBar);
-    addAndMakeVisible(controlBar); 
-    addAndMakeVisible(analyzer);
-    setLookAndFeel(&lnf);
-    addAndMakeVisible(globalControls);
-    addAndMakeVisible(bandControls);
-    
-    setSize (600, 500);
-    
-    startTimerHz(60);
-}
-
-SimpleMBCompAudioProcessorEditor::~SimpleMBCompAudioProcessorEditor()
-{
-    setLookAndFeel(nullptr);
-}
-
-//==============================================================================
-void SimpleMBCompAudioProcessorEditor::paint (juce::Graphics& g)
-{
-    // (Our component is opaque, so we must completely fill the background with a solid colour)
-//    g.fillAll (getLookAndFeel().findColour (juce::ResizableWindow::backgroundColourId));
-//
-//    g.setColour (juce::Colours::white);
-//    g.setFont (15.0f);
-//    g.drawFittedText ("Hello World!", getLocalBounds(), juce::Justification::centred, 1);
-    g.fillAll(juce::Colours::black);
-}
-
-void SimpleMBCompAudioProcessorEditor::resized()
-{
-    // This is generally where you'll want to lay out the positions of any
-    // subcomponents in your editor..
-    auto bounds = getLocalBounds();
-    
-    controlBar.setBounds( bounds.removeFromTop(32) );
-    bandControls.setBounds(bounds.removeFromBottom(135));
-    analyzer.setBounds(bounds.removeFromTop(220));
-    globalControls.setBounds(bounds);
-    
-}
-
-void SimpleMBCompAudioProcessorEditor::timerCallback()
-{
-    std::vector<float> values
-    {
-        audioProcessor.lowBandComp.getRMSInputLevelDb(),
-        audioProcessor.lowBandComp.getRMSOutputLevelDb(),
-        audioProcessor.midBandComp.getRMSInputLevelDb(),
-        audioProcessor.midBandComp.getRMSOutputLevelDb(),
-        audioProcessor.highBandComp.getRMSInputLevelDb(),
-        audioProcessor.highBandComp.getRMSOutputLevelDb()
-    };
-    
-    analyzer.update(values);    
-    
-    updateGlobalBypassButton();
-
-}
-
-void SimpleMBCompAudioProcessorEditor::updateGlobalBypassButton()
-{
-    auto params = getBypassParams();
-    
-    bool allBandsAreBypassed = std::all_of(params.begin(),
-                                           params.end(),
-                                           [](const auto& param) { return param->get(); });
-    
-    controlBar.globalBypassButton.setToggleState( allBandsAreBypassed,
-                                                     juce::NotificationType::dontSendNotification);
-    
-}
-
-void SimpleMBCompAudioProcessorEditor::toggleGlobalBypassState()
-{
-    auto shouldEnableEverything = !controlBar.globalBypassButton.getToggleState();
-    
-    auto params = getBypassParams();
-    
-    auto bypassParamHelper = [](auto* param, bool shouldBeBypassed)
-    {
-        param->beginChangeGesture();
-        param->setValueNotifyingHost(shouldBeBypassed ? 1.f : 0.f );
-        param->endChangeGesture();
-    };
-    
-    for( auto* param : params )
-    {
-        bypassParamHelper(param, !shouldEnableEverything);
-    }
-    
-    bandControls.toggleAllBands(!shouldEnableEverything);  
-}
-    
-std::array<juce::AudioParameterBool*, 3> SimpleMBCompAudioProcessorEditor::getBypassParams()
-{
-    using namespace Params;
-    using namespace juce;
-    const auto& params = Params::GetParams();
-    auto& apvts = audioProcessor.apvts;
-    
-    auto boolHelper = [&apvts, &params](const auto& paramName)
-    {
-        auto param = dynamic_cast<juce::AudioParameterBool*>(apvts.getParameter(params.at(paramName)));
-        jassert( param != nullptr );
-        return param;
-    };
-    auto* lowBypassParam = boolHelper(Names::Bypassed_Low_Band);
-    auto* midBypassParam = boolHelper(Names::Bypassed_Mid_Band);
-    auto* highBypassParam = boolHelper(Names::Bypassed_High_Band);
-    
-    return
-    {
-        lowBypassParam,
-        midBypassParam,
-        highBypassParam
-    };
-}
+/*
+  ==============================================================================
+
+    This file contains the basic framework code for a JUCE plugin editor.
+
+  ==============================================================================
+*/
+
+#include "PluginProcessor.h"
+#include "PluginEditor.h"
+#include "DSP/Params.h"
+
+ControlBar::ControlBar()
+{
+    analyzerButton.setToggleState(true, juce::dontSendNotification);
+    addAndMakeVisible(analyzerButton);
+    
+    analyzerResolution.addItem("2048", FFTOrder::order2048);
+    analyzerResolution.addItem("4096", FFTOrder::order4096);
+    analyzerResolution.addItem("8192", FFTOrder::order8192);
+    analyzerResolution.setSelectedId(FFTOrder::order2048, juce::dontSendNotification);
+    analyzerResolution.setTooltip("analyzer FFT size");
+    addAndMakeVisible(analyzerResolution);
+    
+    analyzerHop.addItem("50%", Overlap50);
+    analyzerHop.addItem("75%", Overlap75);
+    analyzerHop.addItem("87.5%", Overlap875);
+    analyzerHop.addItem("60/s", DisplayRate);
+    analyzerHop.addItem("latest", LatestFrame);
+    analyzerHop.setSelectedId(Overlap75, juce::dontSendNotification);   //PathProducer::DefaultOverlap
+    analyzerHop.setTooltip("analyzer window overlap, FFTs per second, or the latest frame only");
+    addAndMakeVisible(analyzerHop);
+    
+    analyzerColumns.addItem("peak", PeakColumns);
+    analyzerColumns.addItem("avg", AverageColumns);
+    analyzerColumns.setSelectedId(PeakColumns, juce::dontSendNotification);
+    analyzerColumns.setTooltip("analyzer: loudest bin or average power per pixel");
+    addAndMakeVisible(analyzerColumns);
+    addAndMakeVisible(globalBypassButton);
+    addAndMakeVisible(deadlineMeter);
+}
+
+void ControlBar::resized()
+{
+    auto bounds = getLocalBounds();
+    analyzerButton.setBounds(bounds.removeFromLeft(50).withTrimmedTop(4).withTrimmedLeft(4));
+    analyzerResolution.setBounds(bounds.removeFromLeft(70).reduced(4));
+    analyzerHop.setBounds(bounds.removeFromLeft(80).reduced(4));
+    analyzerColumns.setBounds(bounds.removeFromLeft(70).reduced(4));
+    
+    globalBypassButton.setBounds(bounds.removeFromRight(60).withTrimmedTop(2).withTrimmedBottom(2));
+    
+    deadlineMeter.setBounds(bounds.removeFromRight(220).reduced(4));
+}
+
+
+//==============================================================================
+SimpleMBCompAudioProcessorEditor::SimpleMBCompAudioProcessorEditor (SimpleMBCompAudioProcessor& p)
+    : AudioProcessorEditor (&p), audioProcessor (p)
+{
+    // Make sure that before the constructor has finished, you've set the
+    // editor's size to whatever you need it to be.
+    
+    controlBar.analyzerButton.onClick = [this]()
+    {
+        analyzer.toggleAnalysisEnablement(controlBar.analyzerButton.getToggleState());
+    };
+    
+    controlBar.analyzerResolution.onChange = [this]()
+    {
+        analyzer.setFFTOrder(static_cast<FFTOrder>(controlBar.analyzerResolution.getSelectedId()));
+    };
+    
+    controlBar.analyzerHop.onChange = [this]()
+    {
+        auto hop = controlBar.analyzerHop.getSelectedId();
+        analyzer.setLatestFrameWins(hop == ControlBar::LatestFrame);
+        
+        switch( hop )
+        {
+            case ControlBar::Overlap50: analyzer.setAnalysisOverlap(0.5f); break;
+            case ControlBar::Overlap75: analyzer.setAnalysisOverlap(0.75f); break;
+            case ControlBar::Overlap875: analyzer.setAnalysisOverlap(0.875f); break;
+            case ControlBar::DisplayRate: analyzer.setAnalysisFramesPerSecond(static_cast<float>(AnalysisTap::DisplayRateHz)); break;
+            default: break;
+        }
+    };
+    
+    controlBar.analyzerColumns.onChange = [this]()
+    {
+        using ColumnReduction = PathProducer::ColumnReduction;
+        analyzer.setColumnReduction(controlBar.analyzerColumns.getSelectedId() == ControlBar::AverageColumns
+                                    ? ColumnReduction::PowerAverage
+                                    : ColumnReduction::Max);
+    };
+    
+    controlBar.globalBypassButton.onClick = [this]()
+    {
+        toggleGlobalBypassState();
+    };
+    
+    controlBar.deadlineMeter.onClick = [this]()
+    {
+        saveDiagnosticsReport();
+    };
+    
+    //addAndMakeVisible(controlBar);
+    addAndMakeVisible(controlBar); 
+    addAndMakeVisible(analyzer);
+    setLookAndFeel(&lnf.get());
+    addAndMakeVisible(globalControls);
+    addAndMakeVisible(bandControls);
+    
+    setSize (600, 500);
+    
+    startTimerHz(60);
+}
+
+SimpleMBCompAudioProcessorEditor::~SimpleMBCompAudioProcessorEditor()
+{
+    setLookAndFeel(nullptr);
+}
+
+//==============================================================================
+void SimpleMBCompAudioProcessorEditor::paint (juce::Graphics& g)
+{
+    // (Our component is opaque, so we must completely fill the background with a solid colour)
+//    g.fillAll (getLookAndFeel().findColour (juce::ResizableWindow::backgroundColourId));
+//
+//    g.setColour (juce::Colours::white);
+//    g.setFont (15.0f);
+//    g.drawFittedText ("Hello World!", getLocalBounds(), juce::Justification::centred, 1);
+    g.fillAll(juce::Colours::black);
+}
+
+void SimpleMBCompAudioProcessorEditor::resized()
+{
+    // This is generally where you'll want to lay out the positions of any
+    // subcomponents in your editor..
+    auto bounds = getLocalBounds();
+    
+    controlBar.setBounds( bounds.removeFromTop(32) );
+    bandControls.setBounds(bounds.removeFromBottom(135));
+    analyzer.setBounds(bounds.removeFromTop(220));
+    globalControls.setBounds(bounds);
+    
+}
+
+void SimpleMBCompAudioProcessorEditor::timerCallback()
+{
+    std::vector<float> values
+    {
+        audioProcessor.lowBandComp.getRMSInputLevelDb(),
+        audioProcessor.lowBandComp.getRMSOutputLevelDb(),
+        audioProcessor.midBandComp.getRMSInputLevelDb(),
+        audioProcessor.midBandComp.getRMSOutputLevelDb(),
+        audioProcessor.highBandComp.getRMSInputLevelDb(),
+        audioProcessor.highBandComp.getRMSOutputLevelDb()
+    };
+    
+    analyzer.update(values);    
+    
+    updateGlobalBypassButton();
+    
+    controlBar.deadlineMeter.update(audioProcessor.deadlineMonitor.getSnapshot());
+}
+
+void SimpleMBCompAudioProcessorEditor::saveDiagnosticsReport()
+{
+    /*
+     take the report now, not when the user has finished picking a file.
+     */
+    auto report = audioProcessor.getDiagnosticsReport();
+    
+    auto defaultFile = juce::File::getSpecialLocation(juce::File::userDocumentsDirectory)
+                        .getChildFile("SimpleMBComp-diagnostics.txt");
+    
+    fileChooser = std::make_unique<juce::FileChooser>("Save diagnostics", defaultFile, "*.txt");
+    
+    auto flags = juce::FileBrowserComponent::saveMode
+               | juce::FileBrowserComponent::canSelectFiles
+               | juce::FileBrowserComponent::warnAboutOverwriting;
+    
+    fileChooser->launchAsync(flags, [report](const juce::FileChooser& chooser)
+    {
+        auto file = chooser.getResult();
+        if( file != juce::File() )
+            file.replaceWithText(report);
+    });
+}
+
+void SimpleMBCompAudioProcessorEditor::updateGlobalBypassButton()
+{
+    auto params = getBypassParams();
+    
+    bool allBandsAreBypassed = std::all_of(params.begin(),
+                                           params.end(),
+                                           [](const auto& param) { return param->get(); });
+    
+    controlBar.globalBypassButton.setToggleState( allBandsAreBypassed,
+                                                     juce::NotificationType::dontSendNotification);
+    
+}
+
+void SimpleMBCompAudioProcessorEditor::toggleGlobalBypassState()
+{
+    auto shouldEnableEverything = !controlBar.globalBypassButton.getToggleState();
+    
+    auto params = getBypassParams();
+    
+    auto bypassParamHelper = [](auto* param, bool shouldBeBypassed)
+    {
+        param->beginChangeGesture();
+        param->setValueNotifyingHost(shouldBeBypassed ? 1.f : 0.f );
+        param->endChangeGesture();
+    };
+    
+    for( auto* param : params )
+    {
+        bypassParamHelper(param, !shouldEnableEverything);
+    }
+    
+    bandControls.toggleAllBands(!shouldEnableEverything);  
+}
+    
+std::array<juce::AudioParameterBool*, 3> SimpleMBCompAudioProcessorEditor::getBypassParams()
+{
+    using namespace Params;
+    using namespace juce;
+    const auto& params = Params::GetParams();
+    auto& apvts = audioProcessor.apvts;
+    
+    auto boolHelper = [&apvts, &params](const auto& paramName)
+    {
+        auto param = dynamic_cast<juce::AudioParameterBool*>(apvts.getParameter(params.at(paramName)));
+        jassert( param != nullptr );
+        return param;
+    };
+    auto* lowBypassParam = boolHelper(Names::Bypassed_Low_Band);
+    auto* midBypassParam = boolHelper(Names::Bypassed_Mid_Band);
+    auto* highBypassParam = boolHelper(Names::Bypassed_High_Band);
+    
+    return
+    {
+        lowBypassParam,
+        midBypassParam,
+        highBypassParam
+    };
+}
@@ -1,69 +1,107 @@
-/*
-  ==============================================================================
-
-    This file contains the basic framework code for a JUCE plugin editor.
-
-  ==============================================================================
-*/
-
-#pragma once
-
-#include <JuceHeader.h>
-#include "PluginProcessor.h"
-#include "GUI/LookAndFeel.h"
-#include "GUI/GlobalControls.h"
-#include "GUI/CompressorBandControls.h"
-#include "GUI/UtilityComponents.h"
-#include "GUI/SpectrumAnalyzer.h"
-#include "GUI/CustomButtons.h"
-
-
-struct ControlBar : juce::Component
-{
-    ControlBar();
-    void resized() override;
-    
-    AnalyzerButton analyzerButton;
-    
-    PowerButton globalBypassButton;
-    
-
-};
-
-//==============================================================================
-/**
-*/
-class SimpleMBCompAudioProcessorEditor  : public juce::AudioProcessorEditor,
-juce::Timer
-{
-public:
-    SimpleMBCompAudioProcessorEditor (SimpleMBCompAudioProcessor&);
-    ~SimpleMBCompAudioProcessorEditor() override;
-
-    //==============================================================================
-    void paint (juce::Graphics&) override;
-    void resized() override;
-    
-    void timerCallback() override;
-
-private:
-    LookAndFeel lnf; 
-    // This reference is provided as a quick way for your editor to
-    // access the processor object that created it.
-    SimpleMBCompAudioProcessor& audioProcessor;
-    
-    ControlBar controlBar;
-    GlobalControls globalControls {audioProcessor.apvts};
-    CompressorBandControls bandControls {audioProcessor.apvts};
-    SpectrumAnalyzer analyzer {audioProcessor };
-    
-    void toggleGlobalBypassState();
-    
-    std::array<juce::AudioParameterBool*, 3> getBypassParams(); 
-    
-    void updateGlobalBypassButton();
-    
-    
-
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SimpleMBCompAudioProcessorEditor)
-};
+/*
+  ==============================================================================
+
+    This file contains the basic framework code for a JUCE plugin editor.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+#include "GUI/LookAndFeel.h"
+#include "GUI/GlobalControls.h"
+#include "GUI/CompressorBandControls.h"
+#include "GUI/UtilityComponents.h"
+#include "GUI/SpectrumAnalyzer.h"
+#include "GUI/CustomButtons.h"
+#include "GUI/DeadlineMeter.h"
+
+
+struct ControlBar : juce::Component
+{
+    ControlBar();
+    void resized() override;
+    
+    AnalyzerButton analyzerButton;
+    
+    /*
+     the analyzer's FFT size. The item ids are the FFTOrder values.
+     */
+    juce::ComboBox analyzerResolution;
+    
+    /*
+     how far the analyzer's window moves between FFTs.
+     */
+    enum AnalyzerHop
+    {
+        Overlap50 = 1,
+        Overlap75,
+        Overlap875,
+        DisplayRate,    //one FFT per display refresh
+        LatestFrame     //only the newest window, stale frames are skipped
+    };
+    
+    juce::ComboBox analyzerHop;
+    
+    /*
+     how the bins sharing a pixel column are drawn.
+     */
+    enum AnalyzerColumns
+    {
+        PeakColumns = 1,
+        AverageColumns
+    };
+    
+    juce::ComboBox analyzerColumns;
+    
+    PowerButton globalBypassButton;
+    
+    DeadlineMeter deadlineMeter;
+
+};
+
+//==============================================================================
+/**
+*/
+class SimpleMBCompAudioProcessorEditor  : public juce::AudioProcessorEditor,
+juce::Timer
+{
+public:
+    SimpleMBCompAudioProcessorEditor (SimpleMBCompAudioProcessor&);
+    ~SimpleMBCompAudioProcessorEditor() override;
+
+    //==============================================================================
+    void paint (juce::Graphics&) override;
+    void resized() override;
+    
+    void timerCallback() override;
+
+private:
+    /*
+     one LookAndFeel for every editor in the process.
+     */
+    juce::SharedResourcePointer<LookAndFeel> lnf;
+    // This reference is provided as a quick way for your editor to
+    // access the processor object that created it.
+    SimpleMBCompAudioProcessor& audioProcessor;
+    
+    ControlBar controlBar;
+    GlobalControls globalControls {audioProcessor.apvts};
+    CompressorBandControls bandControls {audioProcessor.apvts};
+    SpectrumAnalyzer analyzer {audioProcessor };
+    
+    void toggleGlobalBypassState();
+    
+    std::array<juce::AudioParameterBool*, 3> getBypassParams(); 
+    
+    void updateGlobalBypassButton();
+    
+    void saveDiagnosticsReport();
+    
+    std::unique_ptr<juce::FileChooser> fileChooser;
+    
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SimpleMBCompAudioProcessorEditor)
+};
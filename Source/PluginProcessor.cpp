@@ -1,604 +1,890 @@
-/*
-  ==============================================================================
-
-    This file contains the basic framework code for a JUCE plugin processor.
-
-  ==============================================================================
-*/
-
-#include "PluginProcessor.h"
-#include "PluginEditor.h"
-#include "DSP/Params.h"
-#include "GUI/Utilities.h"
-
-//==============================================================================
-SimpleMBCompAudioProcessor::SimpleMBCompAudioProcessor()
-#ifndef JucePlugin_PreferredChannelConfigurations
-     : AudioProcessor (BusesProperties()
-                     #if ! JucePlugin_IsMidiEffect
-                      #if ! JucePlugin_IsSynth
-                       .withInput  ("Input",  juce::AudioChannelSet::stereo(), true)
-                      #endif
-                       .withOutput ("Output", juce::AudioChannelSet::stereo(), true)
-                     #endif
-                       )
-#endif
-{
-    using namespace Params;
-    const auto& params = GetParams();
-    
-    auto floatHelper = [&apvts = this->apvts, &params](auto& param, const auto& paramName)
-    {
-        param = dynamic_cast<juce::AudioParameterFloat*>(apvts.getParameter(params.at(paramName)));
-        jassert( param != nullptr );
-    };
-    
-    floatHelper(lowBandComp.attack, Names::Attack_Low_Band);
-    floatHelper(lowBandComp.release, Names::Release_Low_Band);
-    floatHelper(lowBandComp.threshold, Names::Threshold_Low_Band);
-    
-    floatHelper(midBandComp.attack, Names::Attack_Mid_Band);
-    floatHelper(midBandComp.release, Names::Release_Mid_Band);
-    floatHelper(midBandComp.threshold, Names::Threshold_Mid_Band);
-    
-    floatHelper(highBandComp.attack, Names::Attack_High_Band);
-    floatHelper(highBandComp.release, Names::Release_High_Band);
-    floatHelper(highBandComp.threshold, Names::Threshold_High_Band);
-    
-    auto choiceHelper = [&apvts = this->apvts, &params](auto& param, const auto& paramName)
-    {
-        param = dynamic_cast<juce::AudioParameterChoice*>(apvts.getParameter(params.at(paramName)));
-        jassert( param != nullptr );
-    };
-    
-    auto boolHelper = [&apvts = this->apvts, &params](auto& param, const auto& paramName)
-    {
-        param = dynamic_cast<juce::AudioParameterBool*>(apvts.getParameter(params.at(paramName)));
-        jassert( param != nullptr );
-    };
-    
-    
-    
-    choiceHelper(lowBandComp.ratio, Names::Ratio_Low_Band);
-    choiceHelper(midBandComp.ratio, Names::Ratio_Mid_Band);
-    choiceHelper(highBandComp.ratio, Names::Ratio_High_Band);
-    
-    boolHelper(lowBandComp.bypassed, Names::Bypassed_Low_Band);
-    boolHelper(midBandComp.bypassed, Names::Bypassed_Mid_Band);
-    boolHelper(highBandComp.bypassed, Names::Bypassed_High_Band);
-    
-    boolHelper(lowBandComp.mute, Names::Mute_Low_Band);
-    boolHelper(midBandComp.mute, Names::Mute_Mid_Band);
-    boolHelper(highBandComp.mute, Names::Mute_High_Band);
-    
-    boolHelper(lowBandComp.solo, Names::Solo_Low_Band);
-    boolHelper(midBandComp.solo, Names::Solo_Mid_Band);
-    boolHelper(highBandComp.solo, Names::Solo_High_Band);
-    
-    floatHelper(lowMidCrossover, Names::Low_Mid_Crossover_Freq);
-    
-    floatHelper(lowMidCrossover, Names::Low_Mid_Crossover_Freq);
-    floatHelper(midHighCrossover, Names::Mid_High_Crossover_Freq);
-    
-    floatHelper(inputGainParam, Names::Gain_In);
-    floatHelper(outputGainParam, Names::Gain_Out);
-    
-    LP1.setType(juce::dsp::LinkwitzRileyFilterType::lowpass);
-    HP1.setType(juce::dsp::LinkwitzRileyFilterType::highpass);
-    
-    
-    
-    AP2.setType(juce::dsp::LinkwitzRileyFilterType::allpass);
-    
-    LP2.setType(juce::dsp::LinkwitzRileyFilterType::lowpass);
-    HP2.setType(juce::dsp::LinkwitzRileyFilterType::highpass);
-    
-//    invAP1.setType(juce::dsp::LinkwitzRileyFilterType::allpass);
-//    invAP2.setType(juce::dsp::LinkwitzRileyFilterType::allpass);
-    
-    
-    /*
-    compressor.attack = dynamic_cast<juce::AudioParameterFloat*>(apvts.getParameter("Attack"));
-    jassert(compressor.attack != nullptr);
-    
-    compressor.release = dynamic_cast<juce::AudioParameterFloat*>(apvts.getParameter("Release"));
-    jassert(compressor.release != nullptr);
-    
-    compressor.threshold = dynamic_cast<juce::AudioParameterFloat*>(apvts.getParameter("Threshold"));
-    jassert(compressor.threshold != nullptr);
-    
-    compressor.ratio = dynamic_cast<juce::AudioParameterChoice*>(apvts.getParameter("Ratio"));
-    jassert(compressor.ratio != nullptr );
-    
-    compressor.bypassed = dynamic_cast<juce::AudioParameterBool*>(apvts.getParameter("Bypassed"));
-    jassert(compressor.bypassed != nullptr);
-     */
-    
-}
-
-SimpleMBCompAudioProcessor::~SimpleMBCompAudioProcessor()
-{
-}
-
-//==============================================================================
-
-juce::AudioProcessorValueTreeState::ParameterLayout SimpleMBCompAudioProcessor::createParameterLayout()
-{
-    APVTS::ParameterLayout layout;
-    using namespace juce;
-    using namespace Params;
-    
-    const auto& params = GetParams();
-    
-    auto gainRange = juce::NormalisableRange<float>(-24.f, 24.f, 0.5f, 1.f);
-    
-    layout.add(std::make_unique<juce::AudioParameterFloat>(params.at(Names::Gain_In),
-                                                           params.at(Names::Gain_In),
-                                                           gainRange,
-                                                           0.f));
-    layout.add(std::make_unique<juce::AudioParameterFloat>(params.at(Names::Gain_Out),
-                                                           params.at(Names::Gain_Out),
-                                                           gainRange,
-                                                           0.f));
-    
-    auto thresholdRange = NormalisableRange<float>(MIN_THRESHOLD, MAX_DECIBELS, 1, 1);
-    
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::Threshold_Low_Band),
-                                                     params.at(Names::Threshold_Low_Band),
-                                                     thresholdRange,
-                                                     0));
-    
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::Threshold_Mid_Band),
-                                                     params.at(Names::Threshold_Mid_Band),
-                                                     thresholdRange,
-                                                     0));
-    
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::Threshold_High_Band),
-                                                     params.at(Names::Threshold_High_Band),
-                                                     thresholdRange,
-                                                     0));
-    
-    auto attackReleaseRange = NormalisableRange<float>{ 5, 500, 1, 1 };
-    
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::Attack_Low_Band),
-                                                     params.at(Names::Attack_Low_Band),
-                                                     attackReleaseRange,
-                                                     50));
-    
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::Attack_Mid_Band),
-                                                    params.at(Names::Attack_Mid_Band),
-                                                    attackReleaseRange,
-                                                    50));
-    
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::Attack_High_Band),
-                                                        params.at(Names::Attack_High_Band),
-                                                        attackReleaseRange,
-                                                        50));
-    
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::Release_Low_Band),
-                                                     params.at(Names::Release_Low_Band),
-                                                     attackReleaseRange,
-                                                     250));
-    
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::Release_Mid_Band),
-                                                         params.at(Names::Release_Mid_Band),
-                                                         attackReleaseRange,
-                                                         250));
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::Release_High_Band),
-                                                         params.at(Names::Release_High_Band),
-                                                         attackReleaseRange,
-                                                         250));
-    
-    auto choices = std::vector<double>{ 1, 1.5, 2, 3, 4, 5, 6, 7, 8, 10, 15, 20, 50, 100 };
-    juce::StringArray sa;
-    for( auto choice : choices )
-    {
-        sa.add( juce::String(choice, 1) );
-    }
-
-    layout.add(std::make_unique<AudioParameterChoice>(params.at(Names::Ratio_Low_Band),
-                                                      params.at(Names::Ratio_Low_Band),
-                                                      sa,
-                                                      3));
-    
-    layout.add(std::make_unique<AudioParameterChoice>(params.at(Names::Ratio_Mid_Band),
-                                                          params.at(Names::Ratio_Mid_Band),
-                                                          sa,
-                                                          3));
-    layout.add(std::make_unique<AudioParameterChoice>(params.at(Names::Ratio_High_Band),
-                                                          params.at(Names::Ratio_High_Band),
-                                                          sa,
-                                                          3));
-
-    layout.add(std::make_unique<AudioParameterBool>(params.at(Names::Bypassed_Low_Band),
-                                                    params.at(Names::Bypassed_Low_Band),
-                                                    false));
-    
-    layout.add(std::make_unique<AudioParameterBool>(params.at(Names::Bypassed_Mid_Band),
-                                                        params.at(Names::Bypassed_Mid_Band),
-                                                        false));
-    
-    layout.add(std::make_unique<AudioParameterBool>(params.at(Names::Bypassed_High_Band),
-                                                        params.at(Names::Bypassed_High_Band),
-                                                        false));
-    
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::Low_Mid_Crossover_Freq),
-                                                     params.at(Names::Low_Mid_Crossover_Freq),
-                                                     NormalisableRange<float>(MIN_FREQUENCY, 999.f, 1.f, 1.f),
-                                                     400));
-    
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::Mid_High_Crossover_Freq),
-                                                     params.at(Names::Mid_High_Crossover_Freq),
-                                                     NormalisableRange<float>(1000.f, MAX_FREQUENCY, 1.f, 1.f),
-                                                     2000.f));
-    
-    layout.add(std::make_unique<AudioParameterBool>(params.at(Names::Mute_Low_Band),
-                                                        params.at(Names::Mute_Low_Band),
-                                                        false));
-    
-    layout.add(std::make_unique<AudioParameterBool>(params.at(Names::Mute_Mid_Band),
-                                                    params.at(Names::Mute_Mid_Band),
-                                                    false));
-    
-    layout.add(std::make_unique<AudioParameterBool>(params.at(Names::Mute_High_Band),
-                                                    params.at(Names::Mute_High_Band),
-                                                    false));
-    
-    layout.add(std::make_unique<AudioParameterBool>(params.at(Names::Solo_Low_Band),
-                                                    params.at(Names::Solo_Low_Band),
-                                                    false));
-    
-    layout.add(std::make_unique<AudioParameterBool>(params.at(Names::Solo_Mid_Band),
-                                                    params.at(Names::Solo_Mid_Band),
-                                                    false));
-    
-    layout.add(std::make_unique<AudioParameterBool>(params.at(Names::Solo_High_Band),
-                                                    params.at(Names::Solo_High_Band),
-                                                    false));
-
-    return layout;
-}
-
-
-//==============================================================================
-
-const juce::String SimpleMBCompAudioProcessor::getName() const
-{
-    return JucePlugin_Name;
-}
-
-bool SimpleMBCompAudioProcessor::acceptsMidi() const
-{
-   #if JucePlugin_WantsMidiInput
-    return true;
-   #else
-    return false;
-   #endif
-}
-
-bool SimpleMBCompAudioProcessor::producesMidi() const
-{
-   #if JucePlugin_ProducesMidiOutput
-    return true;
-   #else
-    return false;
-   #endif
-}
-
-bool SimpleMBCompAudioProcessor::isMidiEffect() const
-{
-   #if JucePlugin_IsMidiEffect
-    return true;
-   #else
-    return false;
-   #endif
-}
-
-double SimpleMBCompAudioProcessor::getTailLengthSeconds() const
-{
-    return 0.0;
-}
-
-int SimpleMBCompAudioProcessor::getNumPrograms()
-{
-    return 1;   // NB: some hosts don't cope very well if you tell them there are 0 programs,
-                // so this should be at least 1, even if you're not really implementing programs.
-}
-
-int SimpleMBCompAudioProcessor::getCurrentProgram()
-{
-    return 0;
-}
-
-void SimpleMBCompAudioProcessor::setCurrentProgram (int index)
-{
-}
-
-const juce::String SimpleMBCompAudioProcessor::getProgramName (int index)
-{
-    return {};
-}
-
-void SimpleMBCompAudioProcessor::changeProgramName (int index, const juce::String& newName)
-{
-}
-
-//==============================================================================
-void SimpleMBCompAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
-{
-    //Use this method as the place to do any pre-playback
-    // initialisation that you need..
-    juce::dsp::ProcessSpec spec;
-    /*
-    It needs to know maximum number of samples it'll process at one time
-    */
-    spec.maximumBlockSize = samplesPerBlock;
-    /*
-    It needs to know the number of channels
-    This compressor can handle multiple channels.
-    we'll use the number of output channels our compressor is configured with.
-    */
-    spec.numChannels = getTotalNumOutputChannels();
-    /*
-    And it need to know the sample rate
-    */
-    spec.sampleRate = sampleRate;
-    /*
-    Now we can pass it to the compressor, which will prepare it.
-    */
-    
-    for( auto& comp : compressors )
-        comp.prepare(spec);
-    
-    LP1.prepare(spec);
-    HP1.prepare(spec);
-    
-    AP2.prepare(spec);
-    
-    LP2.prepare(spec);
-    HP2.prepare(spec);
-    
-//    invAP1.prepare(spec);
-//    invAP2.prepare(spec);
-//    
-//    invAPBuffer.setSize(spec.numChannels, samplesPerBlock);
-    
-    inputGain.prepare(spec);
-    outputGain.prepare(spec);
-        
-    inputGain.setRampDurationSeconds(0.05); //50 ms
-    outputGain.setRampDurationSeconds(0.05);
-
-    
-    for( auto& buffer : filterBuffers )
-    {
-        buffer.setSize(spec.numChannels, samplesPerBlock);
-    }
-    
-    leftChannelFifo.prepare(samplesPerBlock);
-    rightChannelFifo.prepare(samplesPerBlock);
-    
-    osc.initialise([](float x){ return std::sin(x); });
-    osc.prepare(spec);
-    //osc.setFrequency(2000.f);
-    osc.setFrequency(getSampleRate() / ((2 << FFTOrder::order2048) - 1) * 50 );
-    
-    gain.prepare(spec);
-    gain.setGainDecibels(-12.f);
-}
-
-void SimpleMBCompAudioProcessor::releaseResources()
-{
-    // When playback stops, you can use this as an opportunity to free up any
-    // spare memory, etc.
-}
-
-#ifndef JucePlugin_PreferredChannelConfigurations
-bool SimpleMBCompAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts) const
-{
-  #if JucePlugin_IsMidiEffect
-    juce::ignoreUnused (layouts);
-    return true;
-  #else
-    // This is the place where you check if the layout is supported.
-    // In this template code we only support mono or stereo.
-    // Some plugin hosts, such as certain GarageBand versions, will only
-    // load plugins that support stereo bus layouts.
-    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
-     && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
-        return false;
-
-    // This checks if the input layout matches the output layout
-   #if ! JucePlugin_IsSynth
-    if (layouts.getMainOutputChannelSet() != layouts.getMainInputChannelSet())
-        return false;
-   #endif
-
-    return true;
-  #endif
-}
-#endif
-
-
-void SimpleMBCompAudioProcessor::updateState()
-{
-    for( auto& compressor : compressors )
-            compressor.updateCompressorSettings();
-        
-    auto lowMidCutoffFreq = lowMidCrossover->get();
-    LP1.setCutoffFrequency(lowMidCutoffFreq);
-    HP1.setCutoffFrequency(lowMidCutoffFreq);
-    
-    auto midHighCutoffFreq = midHighCrossover->get();
-    LP2.setCutoffFrequency(midHighCutoffFreq);
-    HP2.setCutoffFrequency(midHighCutoffFreq);
-    AP2.setCutoffFrequency(midHighCutoffFreq);
-    
-    inputGain.setGainDecibels(inputGainParam->get());
-    outputGain.setGainDecibels(outputGainParam->get());
-}
-
-void SimpleMBCompAudioProcessor::splitBands(const juce::AudioBuffer<float>& inputBuffer)
-{
-    for( auto& fb : filterBuffers )
-    {
-        fb = inputBuffer;
-    }
-    
-    auto fb0Block = juce::dsp::AudioBlock<float>(filterBuffers[0]);
-    auto fb1Block = juce::dsp::AudioBlock<float>(filterBuffers[1]);
-    auto fb2Block = juce::dsp::AudioBlock<float>(filterBuffers[2]);
-    
-    auto fb0Ctx = juce::dsp::ProcessContextReplacing<float>(fb0Block);
-    auto fb1Ctx = juce::dsp::ProcessContextReplacing<float>(fb1Block);
-    auto fb2Ctx = juce::dsp::ProcessContextReplacing<float>(fb2Block);
-    
-    LP1.process(fb0Ctx);
-    AP2.process(fb0Ctx);
-    
-    HP1.process(fb1Ctx);
-    
-    filterBuffers[2] = filterBuffers[1];
-
-    LP2.process(fb1Ctx);
-    
-    HP2.process(fb2Ctx);
-}
-
-
-void SimpleMBCompAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
-{
-    juce::ScopedNoDenormals noDenormals;
-    auto totalNumInputChannels  = getTotalNumInputChannels();
-    auto totalNumOutputChannels = getTotalNumOutputChannels();
-
-    
-    for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
-        buffer.clear (i, 0, buffer.getNumSamples());
-    
-    
-    updateState();
-    
-    if( false )
-    {
-        buffer.clear();
-        juce::dsp::AudioBlock<float> block(buffer);
-        juce::dsp::ProcessContextReplacing<float> context(block);
-        osc.process(context);
-        
-        gain.setGainDecibels(JUCE_LIVE_CONSTANT(-12));
-        gain.process(context);
-    }
-    
-    leftChannelFifo.update(buffer);
-    rightChannelFifo.update(buffer);
-    
-    
-    applyGain(buffer, inputGain);
-    
-    splitBands(buffer);
-    
-    
-    
-    for( size_t i = 0; i < filterBuffers.size(); ++i )
-    {
-        compressors[i].process(filterBuffers[i]);
-    }
-    
-    
-    auto numSamples = buffer.getNumSamples();
-    auto numChannels = buffer.getNumChannels();
-    
- 
-    buffer.clear();
-    
-    
-    
-    auto addFilterBand = [nc = numChannels, ns = numSamples](auto& inputBuffer, const auto& source)
-    {
-        /*
-         simply loop through all of the channels that were in the input buffer, and copy from a source buffer into the input buffer.
-         */
-        for(auto i = 0; i < nc; ++i )
-        {
-            inputBuffer.addFrom(i, 0, source, i, 0, ns);
-        }
-    };
-    
-    auto bandsAreSoloed = false;
-    for( auto& comp : compressors)
-    {
-        if( comp.solo->get() )
-        {
-            bandsAreSoloed = true;
-            break;
-        }
-    }
-    
-    if( bandsAreSoloed )
-    {
-        for( size_t i = 0; i < compressors.size(); ++i )
-        {
-            auto& comp = compressors[i];
-            if( comp.solo->get() )
-            {
-                addFilterBand(buffer, filterBuffers[i]);
-            }
-        }
-    }
-    else
-    {
-        for( size_t i = 0; i < compressors.size(); ++i )
-        {
-            auto& comp = compressors[i];
-            if( ! comp.mute->get() )
-            {
-                addFilterBand(buffer, filterBuffers[i]);
-            }
-        }
-    }
-    
-    applyGain(buffer, outputGain);
-    
-}
-
-//==============================================================================
-bool SimpleMBCompAudioProcessor::hasEditor() const
-{
-    return true; // (change this to false if you choose to not supply an editor)
-}
-
-juce::AudioProcessorEditor* SimpleMBCompAudioProcessor::createEditor()
-{
-    return new SimpleMBCompAudioProcessorEditor (*this);
-    //return new juce::GenericAudioProcessorEditor(*this);
-}
-
-//==============================================================================
-void SimpleMBCompAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
-{
-    // You should use this method to store your parameters in the memory block.
-    // You could do that either as raw data, or use the XML or ValueTree classes
-    // as intermediaries to make it easy to save and load complex data.
-    juce::MemoryOutputStream mos(destData, true);
-    apvts.state.writeToStream(mos);
-}
-
-void SimpleMBCompAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
-{
-    // You should use this method to restore your parameters from this memory block,
-    // whose contents will have been created by the getStateInformation() call.
-    auto tree = juce::ValueTree::readFromData(data, sizeInBytes);
-        if( tree.isValid() )
-        {
-            apvts.replaceState(tree);
-        }
-    
-}
-
-//==============================================================================
-// This creates new instances of the plugin..
-juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
-{
-    return new SimpleMBCompAudioProcessor();
-}
+/*
+  ==============================================================================
+
+    This file contains the basic framework code for a JUCE plugin processor.
+
+  ==============================================================================
+*/
+
+#include "PluginProcessor.h"
+#include "PluginEditor.h"
+#include "DSP/Params.h"
+#include "GUI/Utilities.h"
+#include "DSP/KernelDispatch.h"
+
+//==============================================================================
+SimpleMBCompAudioProcessor::SimpleMBCompAudioProcessor()
+#ifndef JucePlugin_PreferredChannelConfigurations
+     : AudioProcessor (BusesProperties()
+                     #if ! JucePlugin_IsMidiEffect
+                      #if ! JucePlugin_IsSynth
+                       .withInput  ("Input",  juce::AudioChannelSet::stereo(), true)
+                      #endif
+                       .withOutput ("Output", juce::AudioChannelSet::stereo(), true)
+                     #endif
+                       )
+#endif
+{
+    using namespace Params;
+    const auto& params = GetParams();
+    
+    auto floatHelper = [&apvts = this->apvts, &params](auto& param, const auto& paramName)
+    {
+        param = dynamic_cast<juce::AudioParameterFloat*>(apvts.getParameter(params.at(paramName)));
+        jassert( param != nullptr );
+    };
+    
+    floatHelper(lowBandComp.attack, Names::Attack_Low_Band);
+    floatHelper(lowBandComp.release, Names::Release_Low_Band);
+    floatHelper(lowBandComp.threshold, Names::Threshold_Low_Band);
+    
+    floatHelper(midBandComp.attack, Names::Attack_Mid_Band);
+    floatHelper(midBandComp.release, Names::Release_Mid_Band);
+    floatHelper(midBandComp.threshold, Names::Threshold_Mid_Band);
+    
+    floatHelper(highBandComp.attack, Names::Attack_High_Band);
+    floatHelper(highBandComp.release, Names::Release_High_Band);
+    floatHelper(highBandComp.threshold, Names::Threshold_High_Band);
+    
+    auto choiceHelper = [&apvts = this->apvts, &params](auto& param, const auto& paramName)
+    {
+        param = dynamic_cast<juce::AudioParameterChoice*>(apvts.getParameter(params.at(paramName)));
+        jassert( param != nullptr );
+    };
+    
+    auto boolHelper = [&apvts = this->apvts, &params](auto& param, const auto& paramName)
+    {
+        param = dynamic_cast<juce::AudioParameterBool*>(apvts.getParameter(params.at(paramName)));
+        jassert( param != nullptr );
+    };
+    
+    
+    
+    choiceHelper(lowBandComp.ratio, Names::Ratio_Low_Band);
+    choiceHelper(midBandComp.ratio, Names::Ratio_Mid_Band);
+    choiceHelper(highBandComp.ratio, Names::Ratio_High_Band);
+    
+    boolHelper(lowBandComp.bypassed, Names::Bypassed_Low_Band);
+    boolHelper(midBandComp.bypassed, Names::Bypassed_Mid_Band);
+    boolHelper(highBandComp.bypassed, Names::Bypassed_High_Band);
+    
+    boolHelper(lowBandComp.mute, Names::Mute_Low_Band);
+    boolHelper(midBandComp.mute, Names::Mute_Mid_Band);
+    boolHelper(highBandComp.mute, Names::Mute_High_Band);
+    
+    boolHelper(lowBandComp.solo, Names::Solo_Low_Band);
+    boolHelper(midBandComp.solo, Names::Solo_Mid_Band);
+    boolHelper(highBandComp.solo, Names::Solo_High_Band);
+    
+    floatHelper(lowMidCrossover, Names::Low_Mid_Crossover_Freq);
+    
+    floatHelper(lowMidCrossover, Names::Low_Mid_Crossover_Freq);
+    floatHelper(midHighCrossover, Names::Mid_High_Crossover_Freq);
+    
+    floatHelper(inputGainParam, Names::Gain_In);
+    floatHelper(outputGainParam, Names::Gain_Out);
+    
+//    invAP1.setType(juce::dsp::LinkwitzRileyFilterType::allpass);
+//    invAP2.setType(juce::dsp::LinkwitzRileyFilterType::allpass);
+    
+    
+    /*
+    compressor.attack = dynamic_cast<juce::AudioParameterFloat*>(apvts.getParameter("Attack"));
+    jassert(compressor.attack != nullptr);
+    
+    compressor.release = dynamic_cast<juce::AudioParameterFloat*>(apvts.getParameter("Release"));
+    jassert(compressor.release != nullptr);
+    
+    compressor.threshold = dynamic_cast<juce::AudioParameterFloat*>(apvts.getParameter("Threshold"));
+    jassert(compressor.threshold != nullptr);
+    
+    compressor.ratio = dynamic_cast<juce::AudioParameterChoice*>(apvts.getParameter("Ratio"));
+    jassert(compressor.ratio != nullptr );
+    
+    compressor.bypassed = dynamic_cast<juce::AudioParameterBool*>(apvts.getParameter("Bypassed"));
+    jassert(compressor.bypassed != nullptr);
+     */
+    
+}
+
+SimpleMBCompAudioProcessor::~SimpleMBCompAudioProcessor()
+{
+}
+
+//==============================================================================
+
+juce::AudioProcessorValueTreeState::ParameterLayout SimpleMBCompAudioProcessor::createParameterLayout()
+{
+    APVTS::ParameterLayout layout;
+    using namespace juce;
+    using namespace Params;
+    
+    const auto& params = GetParams();
+    
+    auto gainRange = juce::NormalisableRange<float>(-24.f, 24.f, 0.5f, 1.f);
+    
+    layout.add(std::make_unique<juce::AudioParameterFloat>(params.at(Names::Gain_In),
+                                                           params.at(Names::Gain_In),
+                                                           gainRange,
+                                                           0.f));
+    layout.add(std::make_unique<juce::AudioParameterFloat>(params.at(Names::Gain_Out),
+                                                           params.at(Names::Gain_Out),
+                                                           gainRange,
+                                                           0.f));
+    
+    auto thresholdRange = NormalisableRange<float>(MIN_THRESHOLD, MAX_DECIBELS, 1, 1);
+    
+    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::Threshold_Low_Band),
+                                                     params.at(Names::Threshold_Low_Band),
+                                                     thresholdRange,
+                                                     0));
+    
+    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::Threshold_Mid_Band),
+                                                     params.at(Names::Threshold_Mid_Band),
+                                                     thresholdRange,
+                                                     0));
+    
+    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::Threshold_High_Band),
+                                                     params.at(Names::Threshold_High_Band),
+                                                     thresholdRange,
+                                                     0));
+    
+    auto attackReleaseRange = NormalisableRange<float>{ 5, 500, 1, 1 };
+    
+    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::Attack_Low_Band),
+                                                     params.at(Names::Attack_Low_Band),
+                                                     attackReleaseRange,
+                                                     50));
+    
+    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::Attack_Mid_Band),
+                                                    params.at(Names::Attack_Mid_Band),
+                                                    attackReleaseRange,
+                                                    50));
+    
+    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::Attack_High_Band),
+                                                        params.at(Names::Attack_High_Band),
+                                                        attackReleaseRange,
+                                                        50));
+    
+    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::Release_Low_Band),
+                                                     params.at(Names::Release_Low_Band),
+                                                     attackReleaseRange,
+                                                     250));
+    
+    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::Release_Mid_Band),
+                                                         params.at(Names::Release_Mid_Band),
+                                                         attackReleaseRange,
+                                                         250));
+    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::Release_High_Band),
+                                                         params.at(Names::Release_High_Band),
+                                                         attackReleaseRange,
+                                                         250));
+    
+    auto choices = std::vector<double>{ 1, 1.5, 2, 3, 4, 5, 6, 7, 8, 10, 15, 20, 50, 100 };
+    juce::StringArray sa;
+    for( auto choice : choices )
+    {
+        sa.add( juce::String(choice, 1) );
+    }
+
+    layout.add(std::make_unique<AudioParameterChoice>(params.at(Names::Ratio_Low_Band),
+                                                      params.at(Names::Ratio_Low_Band),
+                                                      sa,
+                                                      3));
+    
+    layout.add(std::make_unique<AudioParameterChoice>(params.at(Names::Ratio_Mid_Band),
+                                                          params.at(Names::Ratio_Mid_Band),
+                                                          sa,
+                                                          3));
+    layout.add(std::make_unique<AudioParameterChoice>(params.at(Names::Ratio_High_Band),
+                                                          params.at(Names::Ratio_High_Band),
+                                                          sa,
+                                                          3));
+
+    layout.add(std::make_unique<AudioParameterBool>(params.at(Names::Bypassed_Low_Band),
+                                                    params.at(Names::Bypassed_Low_Band),
+                                                    false));
+    
+    layout.add(std::make_unique<AudioParameterBool>(params.at(Names::Bypassed_Mid_Band),
+                                                        params.at(Names::Bypassed_Mid_Band),
+                                                        false));
+    
+    layout.add(std::make_unique<AudioParameterBool>(params.at(Names::Bypassed_High_Band),
+                                                        params.at(Names::Bypassed_High_Band),
+                                                        false));
+    
+    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::Low_Mid_Crossover_Freq),
+                                                     params.at(Names::Low_Mid_Crossover_Freq),
+                                                     NormalisableRange<float>(MIN_FREQUENCY, 999.f, 1.f, 1.f),
+                                                     400));
+    
+    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::Mid_High_Crossover_Freq),
+                                                     params.at(Names::Mid_High_Crossover_Freq),
+                                                     NormalisableRange<float>(1000.f, MAX_FREQUENCY, 1.f, 1.f),
+                                                     2000.f));
+    
+    layout.add(std::make_unique<AudioParameterBool>(params.at(Names::Mute_Low_Band),
+                                                        params.at(Names::Mute_Low_Band),
+                                                        false));
+    
+    layout.add(std::make_unique<AudioParameterBool>(params.at(Names::Mute_Mid_Band),
+                                                    params.at(Names::Mute_Mid_Band),
+                                                    false));
+    
+    layout.add(std::make_unique<AudioParameterBool>(params.at(Names::Mute_High_Band),
+                                                    params.at(Names::Mute_High_Band),
+                                                    false));
+    
+    layout.add(std::make_unique<AudioParameterBool>(params.at(Names::Solo_Low_Band),
+                                                    params.at(Names::Solo_Low_Band),
+                                                    false));
+    
+    layout.add(std::make_unique<AudioParameterBool>(params.at(Names::Solo_Mid_Band),
+                                                    params.at(Names::Solo_Mid_Band),
+                                                    false));
+    
+    layout.add(std::make_unique<AudioParameterBool>(params.at(Names::Solo_High_Band),
+                                                    params.at(Names::Solo_High_Band),
+                                                    false));
+
+    return layout;
+}
+
+
+//==============================================================================
+
+const juce::String SimpleMBCompAudioProcessor::getName() const
+{
+    return JucePlugin_Name;
+}
+
+bool SimpleMBCompAudioProcessor::acceptsMidi() const
+{
+   #if JucePlugin_WantsMidiInput
+    return true;
+   #else
+    return false;
+   #endif
+}
+
+bool SimpleMBCompAudioProcessor::producesMidi() const
+{
+   #if JucePlugin_ProducesMidiOutput
+    return true;
+   #else
+    return false;
+   #endif
+}
+
+bool SimpleMBCompAudioProcessor::isMidiEffect() const
+{
+   #if JucePlugin_IsMidiEffect
+    return true;
+   #else
+    return false;
+   #endif
+}
+
+double SimpleMBCompAudioProcessor::getTailLengthSeconds() const
+{
+    return 0.0;
+}
+
+int SimpleMBCompAudioProcessor::getNumPrograms()
+{
+    return 1;   // NB: some hosts don't cope very well if you tell them there are 0 programs,
+                // so this should be at least 1, even if you're not really implementing programs.
+}
+
+int SimpleMBCompAudioProcessor::getCurrentProgram()
+{
+    return 0;
+}
+
+void SimpleMBCompAudioProcessor::setCurrentProgram (int index)
+{
+}
+
+const juce::String SimpleMBCompAudioProcessor::getProgramName (int index)
+{
+    return {};
+}
+
+void SimpleMBCompAudioProcessor::changeProgramName (int index, const juce::String& newName)
+{
+}
+
+//==============================================================================
+void SimpleMBCompAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
+{
+    //Use this method as the place to do any pre-playback
+    // initialisation that you need..
+    juce::dsp::ProcessSpec spec;
+    /*
+    It needs to know maximum number of samples it'll process at one time
+    */
+    maxBlockSize = juce::jmax(1, samplesPerBlock);
+    spec.maximumBlockSize = static_cast<juce::uint32>(maxBlockSize);
+    /*
+    It needs to know the number of channels
+    This compressor can handle multiple channels.
+    we'll use the number of output channels our compressor is configured with.
+    */
+    spec.numChannels = getTotalNumOutputChannels();
+    /*
+    And it need to know the sample rate
+    */
+    spec.sampleRate = sampleRate;
+    /*
+    Now we can pass it to the compressor, which will prepare it.
+    */
+    
+    isArenaReady = allocateArena(spec);
+    
+    /*
+     mono and stereo get kernels with the channel loops unrolled,
+     anything wider goes through the generic ones.
+     */
+    switch( spec.numChannels )
+    {
+        case 1: processEngineFn = &SimpleMBCompAudioProcessor::processEngine<1>; break;
+        case 2: processEngineFn = &SimpleMBCompAudioProcessor::processEngine<2>; break;
+        default: processEngineFn = &SimpleMBCompAudioProcessor::processEngine<0>; break;
+    }
+    
+//    invAP1.prepare(spec);
+//    invAP2.prepare(spec);
+//    
+//    invAPBuffer.setSize(spec.numChannels, samplesPerBlock);
+    
+    inputGain.setRampDurationSeconds(0.05); //50 ms
+    outputGain.setRampDurationSeconds(0.05);
+
+    
+    osc.initialise([](float x){ return std::sin(x); });
+    osc.prepare(spec);
+    //osc.setFrequency(2000.f);
+    osc.setFrequency(getSampleRate() / ((2 << FFTOrder::order2048) - 1) * 50 );
+    
+    gain.prepare(spec);
+    gain.setGainDecibels(-12.f);
+    
+    deadlineMonitor.prepare(sampleRate);
+    silenceDetector.prepare(sampleRate);
+    engineBypass.prepare(sampleRate);
+}
+
+bool SimpleMBCompAudioProcessor::allocateArena(const juce::dsp::ProcessSpec& spec)
+{
+    auto numChannels = static_cast<int>(spec.numChannels);
+    auto maxBlock = static_cast<size_t>(spec.maximumBlockSize);
+    
+    /*
+     the order here is the order processBlock() touches things:
+     input ramp, crossover state, the envelopes, output ramp, the bands,
+     the fused engine's meter sums, the bypass crossfade buffer, and the
+     analysis tap last since the GUI thread reads it.
+     */
+    size_t numBytes = 0;
+    numBytes += DspArena::bytesFor<float>(GainRamp::getStorageSize(spec));
+    numBytes += DspArena::bytesFor<float>(Crossover::getStateSize(numChannels));
+    numBytes += compressors.size() * DspArena::bytesFor<float>(CompressorBand::getStateSize(spec));
+    numBytes += DspArena::bytesFor<float>(GainRamp::getStorageSize(spec));
+    numBytes += filterBuffers.size() * static_cast<size_t>(numChannels) * DspArena::bytesFor<float>(maxBlock);
+    numBytes += 2 * DspArena::bytesFor<float>(compressors.size() * static_cast<size_t>(numChannels));
+    numBytes += static_cast<size_t>(numChannels) * DspArena::bytesFor<float>(maxBlock);
+    numBytes += DspArena::bytesFor<float>(analysisTap.getStorageSize(spec));
+    
+    //the analyzer reads the tap from its own thread, keep it off the old memory.
+    analysisTap.releaseStorage();
+    arena.allocate(numBytes);
+    
+    /*
+     once a carve fails every later one does too, and nothing is prepared
+     with a null pointer: whatever didn't get its memory never runs.
+     */
+    auto carve = [this](size_t count) { return arena.carve<float>(count); };
+    auto carveChannels = [&carve](std::vector<float*>& channels, int num, size_t count)
+    {
+        channels.resize(static_cast<size_t>(num));
+        auto ok = true;
+        for( auto& channel : channels )
+        {
+            channel = carve(count);
+            ok = ok && channel != nullptr;
+        }
+        return ok;
+    };
+    
+    if( auto* storage = carve(GainRamp::getStorageSize(spec)) )
+        inputGain.prepare(spec, storage);
+    else
+        return false;
+    
+    if( auto* storage = carve(Crossover::getStateSize(numChannels)) )
+        crossover.prepare(spec, storage);
+    else
+        return false;
+    
+    for( auto& comp : compressors )
+    {
+        if( auto* storage = carve(CompressorBand::getStateSize(spec)) )
+            comp.prepare(spec, storage);
+        else
+            return false;
+    }
+    
+    if( auto* storage = carve(GainRamp::getStorageSize(spec)) )
+        outputGain.prepare(spec, storage);
+    else
+        return false;
+    
+    for( size_t b = 0; b < filterBuffers.size(); ++b )
+    {
+        if( ! carveChannels(bandChannels[b], numChannels, maxBlock) )
+            return false;
+        
+        filterBuffers[b].setDataToReferTo(bandChannels[b].data(), numChannels, static_cast<int>(maxBlock));
+    }
+    
+    inputSumSquares = carve(compressors.size() * static_cast<size_t>(numChannels));
+    outputSumSquares = carve(compressors.size() * static_cast<size_t>(numChannels));
+    if( inputSumSquares == nullptr || outputSumSquares == nullptr )
+        return false;
+    
+    if( ! carveChannels(allpassChannels, numChannels, maxBlock) )
+        return false;
+    
+    allpassBuffer.setDataToReferTo(allpassChannels.data(), numChannels, static_cast<int>(maxBlock));
+    
+    if( auto* storage = carve(analysisTap.getStorageSize(spec)) )
+        analysisTap.prepare(spec, storage);
+    else
+        return false;
+    
+    jassert(arena.getNumBytesUsed() == numBytes);
+    return true;
+}
+
+void SimpleMBCompAudioProcessor::releaseResources()
+{
+    // When playback stops, you can use this as an opportunity to free up any
+    // spare memory, etc.
+}
+
+#ifndef JucePlugin_PreferredChannelConfigurations
+bool SimpleMBCompAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts) const
+{
+  #if JucePlugin_IsMidiEffect
+    juce::ignoreUnused (layouts);
+    return true;
+  #else
+    // This is the place where you check if the layout is supported.
+    // In this template code we only support mono or stereo.
+    // Some plugin hosts, such as certain GarageBand versions, will only
+    // load plugins that support stereo bus layouts.
+    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
+     && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
+        return false;
+
+    // This checks if the input layout matches the output layout
+   #if ! JucePlugin_IsSynth
+    if (layouts.getMainOutputChannelSet() != layouts.getMainInputChannelSet())
+        return false;
+   #endif
+
+    return true;
+  #endif
+}
+#endif
+
+
+void SimpleMBCompAudioProcessor::updateState()
+{
+    for( auto& compressor : compressors )
+            compressor.updateCompressorSettings();
+        
+    crossover.setCutoffFrequency(0, lowMidCrossover->get());
+    crossover.setCutoffFrequency(1, midHighCrossover->get());
+    
+    inputGain.setGainDecibels(inputGainParam->get());
+    outputGain.setGainDecibels(outputGainParam->get());
+}
+
+SimpleMBCompAudioProcessor::BlockGains SimpleMBCompAudioProcessor::getNextBlockGains(int numSamples)
+{
+    BlockGains gains;
+    gains.inputRamp = inputGain.getNextBlock(numSamples);
+    gains.input = inputGain.getTargetGain();
+    gains.outputRamp = outputGain.getNextBlock(numSamples);
+    gains.output = outputGain.getTargetGain();
+    return gains;
+}
+
+template<int NumChannels>
+void SimpleMBCompAudioProcessor::splitBands(const juce::AudioBuffer<float>& inputBuffer, const BlockGains& gains)
+{
+    auto numChannels = inputBuffer.getNumChannels();
+    auto numSamples = inputBuffer.getNumSamples();
+    
+    /*
+     the bands only ever refer to the arena, so this is just pointer bookkeeping.
+     */
+    for( size_t b = 0; b < filterBuffers.size(); ++b )
+    {
+        jassert(numChannels <= static_cast<int>(bandChannels[b].size()));
+        filterBuffers[b].setDataToReferTo(bandChannels[b].data(), numChannels, numSamples);
+    }
+    
+    crossover.process<NumChannels>(inputBuffer, gains.inputRamp, gains.input, filterBuffers);
+}
+
+
+void SimpleMBCompAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+{
+    juce::ScopedNoDenormals noDenormals;
+    DeadlineMonitor::ScopedBlock deadline(deadlineMonitor, buffer.getNumSamples());
+    
+    auto totalNumInputChannels  = getTotalNumInputChannels();
+    auto totalNumOutputChannels = getTotalNumOutputChannels();
+
+    
+    for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
+        buffer.clear (i, 0, buffer.getNumSamples());
+    
+    //prepareToPlay() couldn't lay out the engine's memory.
+    if( ! isArenaReady )
+    {
+        buffer.clear();
+        return;
+    }
+    
+    /*
+     an idle instance skips everything, including the analyzer taps,
+     until signal comes back.
+     */
+    if( silenceDetector.canSkip(buffer) )
+    {
+        buffer.clear();
+        return;
+    }
+    
+    updateState();
+    
+    if( false )
+    {
+        buffer.clear();
+        juce::dsp::AudioBlock<float> block(buffer);
+        juce::dsp::ProcessContextReplacing<float> context(block);
+        osc.process(context);
+        
+        gain.setGainDecibels(JUCE_LIVE_CONSTANT(-12));
+        gain.process(context);
+    }
+    
+    profiler.beginBlock();
+    using Stage = StageProfiler::Stage;
+    
+    /*
+     the arena only holds maxBlockSize samples per channel, so a host block
+     bigger than the one it announced is processed in slices of that size.
+     subBlock just points into 'buffer', it never allocates.
+     */
+    auto numSamples = buffer.getNumSamples();
+    for( int start = 0; start < numSamples; start += maxBlockSize )
+    {
+        auto n = juce::jmin(maxBlockSize, numSamples - start);
+        subBlock.setDataToReferTo(buffer.getArrayOfWritePointers(), buffer.getNumChannels(), start, n);
+        
+        analysisTap.beginBlock(subBlock);
+        
+        (this->*processEngineFn)(subBlock);
+        
+        StageProfiler::ScopedStage stage(profiler, Stage::AnalysisTap);
+        analysisTap.endBlock(subBlock);
+    }
+    
+    if( silenceDetector.shouldSleepAfter(buffer) )
+        enterSleep();
+}
+
+template<int NumChannels>
+void SimpleMBCompAudioProcessor::sumBands(juce::AudioBuffer<float>& buffer, const BlockGains& gains)
+{
+    auto numSamples = buffer.getNumSamples();
+    auto numChannels = buffer.getNumChannels();
+    
+    /*
+     anything not audible gets a 0 in the mask and is never read.
+     */
+    auto mask = getBandMask();
+    std::array<const float* const*, Crossover::NumBands> bands;
+    for( size_t i = 0; i < compressors.size(); ++i )
+        bands[i] = filterBuffers[i].getArrayOfReadPointers();
+    
+    KernelDispatch::get().sumBands[NumChannels](buffer.getArrayOfWritePointers(),
+                                                bands.data(),
+                                                mask.data(),
+                                                static_cast<int>(bands.size()),
+                                                gains.outputRamp,
+                                                gains.output,
+                                                numChannels,
+                                                numSamples);
+}
+
+template<int NumChannels>
+void SimpleMBCompAudioProcessor::processEngine(juce::AudioBuffer<float>& buffer)
+{
+    if constexpr ( NumChannels > 0 )
+    {
+        //the host handed us a buffer that doesn't match the layout we prepared for.
+        if( buffer.getNumChannels() != NumChannels )
+        {
+            processEngine<0>(buffer);
+            return;
+        }
+    }
+    
+    auto numSamples = buffer.getNumSamples();
+    auto gains = getNextBlockGains(numSamples);
+    auto block = engineBypass.nextBlock(isEngineBypassable(), numSamples, crossover.getLowestCutoff());
+    
+    if( block.seedAllpass )
+    {
+        crossover.seedAllpass();
+        
+        //nothing measures the bands while the engine is bypassed.
+        for( auto& comp : compressors )
+            comp.clearLevels();
+    }
+    
+    if( block.seedEngine )
+        crossover.seedCrossover();
+    
+    if( ! block.runAllpass )
+    {
+        processBands<NumChannels>(buffer, gains);
+        return;
+    }
+    
+    using Stage = StageProfiler::Stage;
+    
+    if( ! block.runEngine )
+    {
+        StageProfiler::ScopedStage stage(profiler, Stage::BypassAllpass);
+        crossover.processAllpass<NumChannels>(buffer, buffer, gains.inputRamp, gains.input, gains.outputRamp, gains.output);
+        return;
+    }
+    
+    /*
+     crossfading: the allpass reads the input before the engine overwrites it.
+     */
+    auto numChannels = buffer.getNumChannels();
+    jassert(numChannels <= static_cast<int>(allpassChannels.size()));
+    allpassBuffer.setDataToReferTo(allpassChannels.data(), numChannels, numSamples);
+    
+    {
+        StageProfiler::ScopedStage stage(profiler, Stage::BypassAllpass);
+        crossover.processAllpass<NumChannels>(buffer, allpassBuffer, gains.inputRamp, gains.input, gains.outputRamp, gains.output);
+    }
+    
+    processBands<NumChannels>(buffer, gains);
+    
+    for( int ch = 0; ch < numChannels; ++ch )
+    {
+        buffer.applyGainRamp(ch, 0, numSamples, block.engineWeightStart, block.engineWeightEnd);
+        buffer.addFromWithRamp(ch, 0, allpassBuffer.getReadPointer(ch), numSamples,
+                               1.f - block.engineWeightStart, 1.f - block.engineWeightEnd);
+    }
+}
+
+bool SimpleMBCompAudioProcessor::isEngineBypassable() const
+{
+    auto allBypassed = std::all_of(compressors.begin(),
+                                   compressors.end(),
+                                   [](const auto& comp) { return comp.bypassed->get(); });
+    
+    auto mask = getBandMask();
+    auto allAudible = std::all_of(mask.begin(), mask.end(), [](float m) { return m == 1.f; });
+    
+    return allBypassed && allAudible;
+}
+
+template<int NumChannels>
+void SimpleMBCompAudioProcessor::processBands(juce::AudioBuffer<float>& buffer, const BlockGains& gains)
+{
+    if( buffer.getNumSamples() <= FusedEngineMaxBlockSize )
+    {
+        processFused<NumChannels>(buffer, gains);
+        return;
+    }
+    
+    using Stage = StageProfiler::Stage;
+    
+    {
+        StageProfiler::ScopedStage stage(profiler, Stage::SplitBands);
+        splitBands<NumChannels>(buffer, gains);
+    }
+    
+    for( size_t i = 0; i < filterBuffers.size(); ++i )
+    {
+        auto band = static_cast<int>(i);
+        analysisTap.captureBand(band, false, filterBuffers[i]);
+        
+        {
+            StageProfiler::ScopedStage stage(profiler, Stage::CompressLowBand + band);
+            compressors[i].process<NumChannels>(filterBuffers[i]);
+        }
+        
+        analysisTap.captureBand(band, true, filterBuffers[i]);
+    }
+    
+    {
+        StageProfiler::ScopedStage stage(profiler, Stage::Summation);
+        sumBands<NumChannels>(buffer, gains);
+    }
+}
+
+std::array<float, Crossover::NumBands> SimpleMBCompAudioProcessor::getBandMask() const
+{
+    auto bandsAreSoloed = std::any_of(compressors.begin(),
+                                      compressors.end(),
+                                      [](const auto& comp) { return comp.solo->get(); });
+    
+    /*
+     soloed bands win over muted ones.
+     */
+    std::array<float, Crossover::NumBands> mask;
+    for( size_t i = 0; i < compressors.size(); ++i )
+    {
+        auto& comp = compressors[i];
+        auto isAudible = bandsAreSoloed ? comp.solo->get() : ! comp.mute->get();
+        
+        mask[i] = isAudible ? 1.f : 0.f;
+    }
+    
+    return mask;
+}
+
+template<int NumChannels>
+void SimpleMBCompAudioProcessor::processFused(juce::AudioBuffer<float>& buffer, const BlockGains& gains)
+{
+    StageProfiler::ScopedStage stage(profiler, StageProfiler::Stage::FusedEngine);
+    
+    auto numSamples = buffer.getNumSamples();
+    auto numChannels = NumChannels > 0 ? NumChannels : juce::jmin(buffer.getNumChannels(), getTotalNumOutputChannels());
+    
+    /*
+     same state, same maths as the block engine, so switching between the two
+     from one block to the next is seamless.
+     */
+    auto mask = getBandMask();
+    std::array<Kernels::FusedBand, Crossover::NumBands> bands;
+    for( size_t b = 0; b < bands.size(); ++b )
+    {
+        bands[b] = compressors[b].getFusedBand();
+        bands[b].mask = mask[b];
+        bands[b].inputSumSquares = inputSumSquares + b * static_cast<size_t>(numChannels);
+        bands[b].outputSumSquares = outputSumSquares + b * static_cast<size_t>(numChannels);
+        
+        bands[b].preTap = analysisTap.getStagingLane(AnalysisTap::getBandLane(static_cast<int>(b), false));
+        bands[b].postTap = analysisTap.getStagingLane(AnalysisTap::getBandLane(static_cast<int>(b), true));
+        bands[b].tapGain = 1.f / static_cast<float>(numChannels);
+    }
+    
+    auto meterSize = compressors.size() * static_cast<size_t>(numChannels);
+    std::fill(inputSumSquares, inputSumSquares + meterSize, 0.f);
+    std::fill(outputSumSquares, outputSumSquares + meterSize, 0.f);
+    
+    crossover.processFused<NumChannels>(buffer,
+                                        gains.inputRamp,
+                                        gains.input,
+                                        gains.outputRamp,
+                                        gains.output,
+                                        bands.data());
+    
+    for( size_t b = 0; b < bands.size(); ++b )
+    {
+        compressors[b].updateLevels(bands[b].inputSumSquares,
+                                    bands[b].outputSumSquares,
+                                    numChannels,
+                                    numSamples);
+    }
+}
+
+void SimpleMBCompAudioProcessor::enterSleep()
+{
+    /*
+     input and output have been below the floor for a while, so whatever is
+     left in the filters and envelopes is inaudible. Clearing it now means
+     processing restarts from a clean state when signal returns, with nothing
+     left over to click.
+     */
+    crossover.reset();
+    engineBypass.reset();
+    
+    for( auto& comp : compressors )
+        comp.reset();
+    
+    //the output is silent while asleep, so the gain ramps can jump to their targets.
+    inputGain.reset();
+    outputGain.reset();
+}
+
+juce::String SimpleMBCompAudioProcessor::getDiagnosticsReport() const
+{
+    juce::String str;
+    str << getName() << " diagnostics, " << juce::Time::getCurrentTime().toString(true, true) << juce::newLine;
+    str << getSampleRate() << " Hz, " << getBlockSize() << " samples, "
+        << getTotalNumOutputChannels() << " channels"
+        << (isSleeping() ? ", asleep" : "") << juce::newLine << juce::newLine;
+    
+    str << "deadline" << juce::newLine << deadlineMonitor.getSnapshot().toString() << juce::newLine;
+    str << "stages" << juce::newLine << profiler.getSnapshot().toString() << juce::newLine;
+    str << "analysis tap, " << analysisTap.getNumFrames() << " frames of "
+        << analysisTap.getFrameSize() << " at " << analysisTap.getSampleRate() << " Hz"
+        << (analysisTap.isActive() ? "" : ", idle") << juce::newLine;
+    str << analysisTap.getCounters().toString() << juce::newLine;
+    return str;
+}
+
+//==============================================================================
+bool SimpleMBCompAudioProcessor::hasEditor() const
+{
+    return true; // (change this to false if you choose to not supply an editor)
+}
+
+juce::AudioProcessorEditor* SimpleMBCompAudioProcessor::createEditor()
+{
+    return new SimpleMBCompAudioProcessorEditor (*this);
+    //return new juce::GenericAudioProcessorEditor(*this);
+}
+
+//==============================================================================
+void SimpleMBCompAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
+{
+    // You should use this method to store your parameters in the memory block.
+    // You could do that either as raw data, or use the XML or ValueTree classes
+    // as intermediaries to make it easy to save and load complex data.
+    juce::MemoryOutputStream mos(destData, true);
+    apvts.state.writeToStream(mos);
+}
+
+void SimpleMBCompAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
+{
+    // You should use this method to restore your parameters from this memory block,
+    // whose contents will have been created by the getStateInformation() call.
+    auto tree = juce::ValueTree::readFromData(data, sizeInBytes);
+        if( tree.isValid() )
+        {
+            apvts.replaceState(tree);
+        }
+    
+}
+
+//==============================================================================
+// This creates new instances of the plugin..
+juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
+{
+    return new SimpleMBCompAudioProcessor();
+}
@@ -1,118 +1,231 @@
-/*
-  ==============================================================================
-
-    This file contains the basic framework code for a JUCE plugin processor.
-
-  ==============================================================================
-*/
-
-#pragma once
-
-#include <JuceHeader.h>
-#include "DSP/CompressorBand.h"
-#include "DSP/SingleChannelSampleFifo.h"
-
-
-
-//==============================================================================
-/**
-*/
-class SimpleMBCompAudioProcessor  : public juce::AudioProcessor
-{
-public:
-    //==============================================================================
-    SimpleMBCompAudioProcessor();
-    ~SimpleMBCompAudioProcessor() override;
-
-    //==============================================================================
-    void prepareToPlay (double sampleRate, int samplesPerBlock) override;
-    void releaseResources() override;
-
-   #ifndef JucePlugin_PreferredChannelConfigurations
-    bool isBusesLayoutSupported (const BusesLayout& layouts) const override;
-   #endif
-
-    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
-
-    //==============================================================================
-    juce::AudioProcessorEditor* createEditor() override;
-    bool hasEditor() const override;
-
-    //==============================================================================
-    const juce::String getName() const override;
-
-    bool acceptsMidi() const override;
-    bool producesMidi() const override;
-    bool isMidiEffect() const override;
-    double getTailLengthSeconds() const override;
-
-    //==============================================================================
-    int getNumPrograms() override;
-    int getCurrentProgram() override;
-    void setCurrentProgram (int index) override;
-    const juce::String getProgramName (int index) override;
-    void changeProgramName (int index, const juce::String& newName) override;
-
-    //==============================================================================
-    void getStateInformation (juce::MemoryBlock& destData) override;
-    void setStateInformation (const void* data, int sizeInBytes) override;
-    
-    using APVTS = juce::AudioProcessorValueTreeState;
-    static APVTS::ParameterLayout createParameterLayout();
-    
-    APVTS apvts{*this, nullptr, "Parameters", createParameterLayout()};
-    
-    using BlockType = juce::AudioBuffer<float>;
-    SingleChannelSampleFifo<BlockType> leftChannelFifo { Channel::Left };
-    SingleChannelSampleFifo<BlockType> rightChannelFifo { Channel::Right };
-    
-    std::array<CompressorBand, 3> compressors;
-    
-    //Create aliases to each one
-    CompressorBand& lowBandComp = compressors[0];
-    CompressorBand& midBandComp = compressors[1];
-    CompressorBand& highBandComp = compressors[2];
-    
-
-private:
-    
-    using Filter = juce::dsp::LinkwitzRileyFilter<float>;
-    
-    //      Fc0     Fc1
-    Filter  LP1,    AP2,
-            HP1,    LP2,
-                    HP2;
-    
-//    Filter invAP1, invAP2;
-//    juce::AudioBuffer<float> invAPBuffer;
-    
-    
-    juce::AudioParameterFloat* lowMidCrossover { nullptr };
-    juce::AudioParameterFloat* midHighCrossover { nullptr };
-    
-    std::array<juce::AudioBuffer<float>, 3> filterBuffers;
-    
-    juce::dsp::Gain<float> inputGain, outputGain;
-    juce::AudioParameterFloat* inputGainParam { nullptr };
-    juce::AudioParameterFloat* outputGainParam { nullptr };
-    
-    template<typename T, typename U>
-    void applyGain(T& buffer, U& gain)
-    {
-        auto block = juce::dsp::AudioBlock<float>(buffer);
-        auto ctx = juce::dsp::ProcessContextReplacing<float>(block);
-        gain.process(ctx);
-    }
-    
-    void updateState();
-    
-    void splitBands(const juce::AudioBuffer<float>& inputBuffer);
-    
-    juce::dsp::Oscillator<float> osc;
-    
-    juce::dsp::Gain<float> gain;
-    
-    
-    //==============================================================================
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SimpleMBCompAudioProcessor)
-};
+/*
+  ==============================================================================
+
+    This file contains the basic framework code for a JUCE plugin processor.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "DSP/CompressorBand.h"
+#include "DSP/AnalysisTap.h"
+#include "DSP/StageProfiler.h"
+#include "DSP/DeadlineMonitor.h"
+#include "DSP/SilenceDetector.h"
+#include "DSP/GainRamp.h"
+#include "DSP/Crossover.h"
+#include "DSP/DspArena.h"
+#include "DSP/EngineBypass.h"
+
+
+
+//==============================================================================
+/**
+*/
+class SimpleMBCompAudioProcessor  : public juce::AudioProcessor
+{
+public:
+    //==============================================================================
+    SimpleMBCompAudioProcessor();
+    ~SimpleMBCompAudioProcessor() override;
+
+    //==============================================================================
+    void prepareToPlay (double sampleRate, int samplesPerBlock) override;
+    void releaseResources() override;
+
+   #ifndef JucePlugin_PreferredChannelConfigurations
+    bool isBusesLayoutSupported (const BusesLayout& layouts) const override;
+   #endif
+
+    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+
+    //==============================================================================
+    juce::AudioProcessorEditor* createEditor() override;
+    bool hasEditor() const override;
+
+    //==============================================================================
+    const juce::String getName() const override;
+
+    bool acceptsMidi() const override;
+    bool producesMidi() const override;
+    bool isMidiEffect() const override;
+    double getTailLengthSeconds() const override;
+
+    //==============================================================================
+    int getNumPrograms() override;
+    int getCurrentProgram() override;
+    void setCurrentProgram (int index) override;
+    const juce::String getProgramName (int index) override;
+    void changeProgramName (int index, const juce::String& newName) override;
+
+    //==============================================================================
+    void getStateInformation (juce::MemoryBlock& destData) override;
+    void setStateInformation (const void* data, int sizeInBytes) override;
+    
+    using APVTS = juce::AudioProcessorValueTreeState;
+    static APVTS::ParameterLayout createParameterLayout();
+    
+    APVTS apvts{*this, nullptr, "Parameters", createParameterLayout()};
+    
+    using BlockType = juce::AudioBuffer<float>;
+    
+    /*
+     input, output and every band before and after its compressor, for the analyzer.
+     */
+    AnalysisTap analysisTap;
+    
+    std::array<CompressorBand, Crossover::NumBands> compressors;
+    
+    //Create aliases to each one
+    CompressorBand& lowBandComp = compressors[0];
+    CompressorBand& midBandComp = compressors[1];
+    CompressorBand& highBandComp = compressors[2];
+    
+    StageProfiler profiler;
+    DeadlineMonitor deadlineMonitor;
+    
+    /*
+     plain-text summary of the profiler and deadline monitor, safe to call from any thread.
+     */
+    juce::String getDiagnosticsReport() const;
+    
+    bool isSleeping() const { return silenceDetector.isSleeping(); }
+    
+
+private:
+    
+    /*
+     the band layout is declared once, in DspGraph::Topology.
+     */
+    Crossover crossover;
+    
+//    Filter invAP1, invAP2;
+//    juce::AudioBuffer<float> invAPBuffer;
+    
+    
+    juce::AudioParameterFloat* lowMidCrossover { nullptr };
+    juce::AudioParameterFloat* midHighCrossover { nullptr };
+    
+    /*
+     filterBuffers refer to channels carved from 'arena', they never allocate.
+     */
+    Crossover::BandBuffers filterBuffers;
+    std::array<std::vector<float*>, Crossover::NumBands> bandChannels;
+    
+    /*
+     everything the audio thread writes to, laid out in processing order.
+     */
+    DspArena arena;
+    
+    /*
+     returns false if the arena couldn't hold everything. The instance then
+     stays unprepared and processBlock() outputs silence.
+     */
+    bool allocateArena(const juce::dsp::ProcessSpec& spec);
+    bool isArenaReady = false;
+    
+    /*
+     the block size the arena was laid out for, and a view into the host's
+     buffer used to process larger blocks in slices of that size.
+     */
+    int maxBlockSize = 1;
+    juce::AudioBuffer<float> subBlock;
+    
+    GainRamp inputGain, outputGain;
+    juce::AudioParameterFloat* inputGainParam { nullptr };
+    juce::AudioParameterFloat* outputGainParam { nullptr };
+    
+    void updateState();
+    
+    /*
+     a ramp may only advance once per block, so both are fetched up front and
+     handed to whichever of the engine and the bypass allpass run.
+     */
+    struct BlockGains
+    {
+        const float* inputRamp = nullptr;
+        float input = 1.f;
+        const float* outputRamp = nullptr;
+        float output = 1.f;
+    };
+    
+    BlockGains getNextBlockGains(int numSamples);
+    
+    /*
+     everything after the analyzer taps, with the channel count fixed at
+     compile time (NumChannels > 0) or taken from the buffer (0).
+     prepareToPlay() picks the specialisation that matches the bus layout.
+     */
+    template<int NumChannels>
+    void processEngine(juce::AudioBuffer<float>& buffer);
+    
+    /*
+     split, compress and sum.
+     */
+    template<int NumChannels>
+    void processBands(juce::AudioBuffer<float>& buffer, const BlockGains& gains);
+    
+    /*
+     with every band bypassed and audible, the engine is just an allpass.
+     engineBypass runs the crossover's allpass chain instead, and both for the
+     short crossfade on the way back.
+     */
+    EngineBypass engineBypass;
+    bool isEngineBypassable() const;
+    
+    /*
+     the allpass output while crossfading, carved from the arena.
+     */
+    juce::AudioBuffer<float> allpassBuffer;
+    std::vector<float*> allpassChannels;
+    
+    /*
+     below this many samples per block, processBands() hands over to
+     processFused(), which carries each sample through every stage in one loop.
+     */
+    static constexpr int FusedEngineMaxBlockSize = 64;
+    
+    template<int NumChannels>
+    void processFused(juce::AudioBuffer<float>& buffer, const BlockGains& gains);
+    
+    /*
+     one float per band per channel, for the fused engine's level meters.
+     */
+    float* inputSumSquares = nullptr;
+    float* outputSumSquares = nullptr;
+    
+    /*
+     1 for every band that should be heard: soloed bands win over muted ones.
+     */
+    std::array<float, Crossover::NumBands> getBandMask() const;
+    
+    using ProcessEngineFn = void (SimpleMBCompAudioProcessor::*)(juce::AudioBuffer<float>&);
+    ProcessEngineFn processEngineFn = &SimpleMBCompAudioProcessor::processEngine<0>;
+    
+    /*
+     splits 'inputBuffer' into filterBuffers in a single pass,
+     applying the input gain as each sample is read.
+     */
+    template<int NumChannels>
+    void splitBands(const juce::AudioBuffer<float>& inputBuffer, const BlockGains& gains);
+    
+    /*
+     writes the masked sum of the bands, with the output gain applied, into 'buffer'.
+     */
+    template<int NumChannels>
+    void sumBands(juce::AudioBuffer<float>& buffer, const BlockGains& gains);
+    
+    SilenceDetector silenceDetector;
+    
+    void enterSleep();
+    
+    juce::dsp::Oscillator<float> osc;
+    
+    juce::dsp::Gain<float> gain;
+    
+    
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SimpleMBCompAudioProcessor)
+};
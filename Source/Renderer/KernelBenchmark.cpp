@@ -0,0 +1,173 @@
+/*
+  ==============================================================================
+
+    KernelBenchmark.cpp
+    Created: 19 Oct 2026 8:31:05pm
+    Author:  Marc Woodbury-Smith
+
+  ==============================================================================
+*/
+
+#include "KernelBenchmark.h"
+
+namespace
+{
+int getSpecialisation(int numChannels)
+{
+    return numChannels < KernelDispatch::KernelSet::NumSpecialisations ? numChannels : 0;
+}
+
+template<typename Fn>
+double measureMsps(const KernelBenchmark::Settings& settings, Fn&& processBlock)
+{
+    auto numBlocks = static_cast<int>(std::ceil(settings.audioSeconds * settings.sampleRate / settings.blockSize));
+    
+    auto start = juce::Time::getHighResolutionTicks();
+    for( int b = 0; b < numBlocks; ++b )
+        processBlock();
+    auto seconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+    
+    return seconds > 0.0 ? (double)numBlocks * settings.blockSize / seconds / 1.0e6 : 0.0;
+}
+
+/*
+ for kernels that work in place: 'restoreInput' puts the block's input back
+ before every call and isn't timed, so only the kernel itself is measured.
+ */
+template<typename Restore, typename Fn>
+double measureMsps(const KernelBenchmark::Settings& settings, Restore&& restoreInput, Fn&& processBlock)
+{
+    auto numBlocks = static_cast<int>(std::ceil(settings.audioSeconds * settings.sampleRate / settings.blockSize));
+    
+    juce::int64 ticks = 0;
+    for( int b = 0; b < numBlocks; ++b )
+    {
+        restoreInput();
+        
+        auto start = juce::Time::getHighResolutionTicks();
+        processBlock();
+        ticks += juce::Time::getHighResolutionTicks() - start;
+    }
+    auto seconds = juce::Time::highResolutionTicksToSeconds(ticks);
+    
+    return seconds > 0.0 ? (double)numBlocks * settings.blockSize / seconds / 1.0e6 : 0.0;
+}
+} //end anonymous namespace
+
+std::vector<KernelBenchmark::Result> KernelBenchmark::run(const Settings& settings)
+{
+    const auto numChannels = settings.numChannels;
+    const auto numSamples = settings.blockSize;
+    const auto specialisation = getSpecialisation(numChannels);
+    
+    juce::Random random(0x5eed);
+    juce::AudioBuffer<float> input(numChannels, numSamples);
+    for( int ch = 0; ch < numChannels; ++ch )
+        for( int i = 0; i < numSamples; ++i )
+            input.setSample(ch, i, random.nextFloat() * 2.f - 1.f);
+    
+    std::array<juce::AudioBuffer<float>, DspGraph::NumBands> bands;
+    for( auto& band : bands )
+        band.setSize(numChannels, numSamples);
+    
+    juce::AudioBuffer<float> output(numChannels, numSamples);
+    std::vector<float> crossoverState(static_cast<size_t>(numChannels * Kernels::NumCrossoverStates), 0.f);
+    std::vector<float> envelopes(static_cast<size_t>(numChannels), 0.f);
+    std::vector<float> magnitudes(static_cast<size_t>(numSamples));
+    
+    //what magnitudesToDecibels() converts, built once.
+    std::vector<float> inputMagnitudes(static_cast<size_t>(numSamples));
+    for( int i = 0; i < numSamples; ++i )
+        inputMagnitudes[(size_t)i] = std::abs(input.getSample(0, i));
+    
+    //crossovers spread log-evenly between 200 Hz and 5 kHz
+    std::array<Kernels::LinkwitzRileyCoefficients, DspGraph::NumCrossovers> crossovers;
+    for( size_t c = 0; c < crossovers.size(); ++c )
+    {
+        auto position = (c + 1.f) / (crossovers.size() + 1.f);
+        crossovers[c] = Kernels::LinkwitzRileyCoefficients::make(juce::mapToLog10(position, 200.f, 5000.f), settings.sampleRate);
+    }
+    
+    Kernels::CompressorCoefficients compressor;
+    compressor.threshold = juce::Decibels::decibelsToGain(-18.f);
+    compressor.thresholdInverse = 1.f / compressor.threshold;
+    compressor.ratioInverse = 1.f / 4.f;
+    compressor.cteAT = std::exp(-2.f * juce::MathConstants<float>::pi * 1000.f / (float)settings.sampleRate / 50.f);
+    compressor.cteRL = std::exp(-2.f * juce::MathConstants<float>::pi * 1000.f / (float)settings.sampleRate / 250.f);
+    
+    std::array<float, DspGraph::NumBands> mask;
+    mask.fill(1.f);
+    
+    std::array<const float* const*, DspGraph::NumBands> bandPointers;
+    std::array<float* const*, DspGraph::NumBands> bandWritePointers;
+    for( size_t b = 0; b < bands.size(); ++b )
+    {
+        bandPointers[b] = bands[b].getArrayOfReadPointers();
+        bandWritePointers[b] = bands[b].getArrayOfWritePointers();
+    }
+    
+    std::vector<Result> results;
+    for( const auto* set : KernelDispatch::getAvailable() )
+    {
+        Result result;
+        result.isa = set->isa;
+        
+        result.splitMsps = measureMsps(settings, [&]()
+        {
+            set->splitBands[(size_t)specialisation](input.getArrayOfReadPointers(), nullptr, 1.f,
+                                                    bandWritePointers.data(), crossoverState.data(),
+                                                    crossovers.data(), numChannels, numSamples);
+        });
+        
+        result.compressMsps = measureMsps(settings,
+                                          [&]() { output.makeCopyOf(input, true); },
+                                          [&]()
+        {
+            set->compress[(size_t)specialisation](output.getArrayOfWritePointers(), envelopes.data(),
+                                                  compressor, numChannels, numSamples);
+        });
+        
+        result.sumMsps = measureMsps(settings, [&]()
+        {
+            set->sumBands[(size_t)specialisation](output.getArrayOfWritePointers(), bandPointers.data(),
+                                                  mask.data(), static_cast<int>(bands.size()),
+                                                  nullptr, 0.5f, numChannels, numSamples);
+        });
+        
+        result.decibelMsps = measureMsps(settings,
+                                         [&]() { std::copy(inputMagnitudes.begin(), inputMagnitudes.end(), magnitudes.begin()); },
+                                         [&]()
+        {
+            set->magnitudesToDecibels(magnitudes.data(), numSamples, 1.f, -100.f);
+        });
+        
+        results.push_back(result);
+    }
+    
+    return results;
+}
+
+juce::String KernelBenchmark::toString(const Settings& settings, const std::vector<Result>& results)
+{
+    juce::String str;
+    str << "kernel benchmark: " << settings.numChannels << " channels, "
+        << settings.blockSize << " samples per block" << juce::newLine;
+    str << "selected variant: " << KernelDispatch::getIsaName(KernelDispatch::get().isa) << juce::newLine << juce::newLine;
+    
+    str << juce::String("variant").paddedRight(' ', 12)
+        << juce::String("split").paddedLeft(' ', 12)
+        << juce::String("compress").paddedLeft(' ', 12)
+        << juce::String("sum").paddedLeft(' ', 12)
+        << juce::String("dB").paddedLeft(' ', 12)
+        << "   (Msamples/s per channel)" << juce::newLine;
+    
+    for( const auto& result : results )
+    {
+        str << juce::String(KernelDispatch::getIsaName(result.isa)).paddedRight(' ', 12)
+            << juce::String(result.splitMsps, 1).paddedLeft(' ', 12)
+            << juce::String(result.compressMsps, 1).paddedLeft(' ', 12)
+            << juce::String(result.sumMsps, 1).paddedLeft(' ', 12)
+            << juce::String(result.decibelMsps, 1).paddedLeft(' ', 12) << juce::newLine;
+    }
+    return str;
+}
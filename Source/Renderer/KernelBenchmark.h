@@ -0,0 +1,43 @@
+/*
+  ==============================================================================
+
+    KernelBenchmark.h
+    Created: 19 Oct 2026 8:31:05pm
+    Author:  Marc Woodbury-Smith
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "../DSP/KernelDispatch.h"
+
+/*
+ Times every KernelDispatch variant this CPU can run on synthetic noise,
+ so the variant get() picks can be compared with the others.
+ */
+struct KernelBenchmark
+{
+    struct Settings
+    {
+        int numChannels = 2;
+        int blockSize = 512;
+        double sampleRate = 48000.0;
+        double audioSeconds = 60.0;     //of audio pushed through each kernel
+    };
+    
+    struct Result
+    {
+        KernelDispatch::Isa isa = KernelDispatch::Isa::Baseline;
+        
+        //millions of samples (per channel) per second
+        double splitMsps = 0.0;
+        double compressMsps = 0.0;
+        double sumMsps = 0.0;
+        double decibelMsps = 0.0;
+    };
+    
+    static std::vector<Result> run(const Settings& settings);
+    
+    static juce::String toString(const Settings& settings, const std::vector<Result>& results);
+};
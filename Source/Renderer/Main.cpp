@@ -0,0 +1,120 @@
+/*
+  ==============================================================================
+
+    This file contains the basic startup code for a JUCE application.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "OfflineRenderer.h"
+#include "KernelBenchmark.h"
+
+namespace
+{
+void printUsage()
+{
+    std::cout << "usage: SimpleMBCompRenderer [options] <input> <output>" << std::endl
+              << "       SimpleMBCompRenderer --benchmark [--channels=<n>] [--block=<n>]" << std::endl
+              << std::endl
+              << "  --state=<file>    restore a state blob saved by the plugin" << std::endl
+              << "  --params=<file>   apply 'Parameter Name = value' lines after the state" << std::endl
+              << "  --block=<n>       processing block size (default 512)" << std::endl
+              << "  --bits=<n>        output bit depth (default 24)" << std::endl
+              << "  --threads=<n|all> render segments of the file in parallel (default 1)" << std::endl
+              << "  --segment=<s>     segment length in seconds (default 60)" << std::endl
+              << "  --preroll=<s>     warm-up audio processed before each segment (default 2)" << std::endl
+              << "  --verify[=<dB>]   compare against a serial render (default tolerance -80 dB)" << std::endl
+              << "  --benchmark       time every DSP kernel variant this CPU supports" << std::endl;
+}
+}
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    /*
+     the processor's APVTS and parameters expect a MessageManager to exist.
+     */
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::ArgumentList args(argc, argv);
+
+    juce::StringArray files;
+    for( int i = 0; i < args.size(); ++i )
+    {
+        if( ! args[i].isOption() )
+            files.add(args[i].text);
+    }
+
+    if( args.containsOption("--benchmark") )
+    {
+        KernelBenchmark::Settings benchmarkSettings;
+        if( args.containsOption("--channels") )
+            benchmarkSettings.numChannels = juce::jmax(1, args.getValueForOption("--channels").getIntValue());
+        
+        if( args.containsOption("--block") )
+            benchmarkSettings.blockSize = juce::jmax(1, args.getValueForOption("--block").getIntValue());
+        
+        auto results = KernelBenchmark::run(benchmarkSettings);
+        std::cout << KernelBenchmark::toString(benchmarkSettings, results);
+        return 0;
+    }
+
+    if( files.size() != 2 || args.containsOption("--help|-h") )
+    {
+        printUsage();
+        return files.size() == 2 ? 0 : 1;
+    }
+
+    OfflineRenderer::Settings settings;
+    settings.inputFile = juce::File::getCurrentWorkingDirectory().getChildFile(files[0]);
+    settings.outputFile = juce::File::getCurrentWorkingDirectory().getChildFile(files[1]);
+
+    if( args.containsOption("--state") )
+        settings.stateFile = juce::File::getCurrentWorkingDirectory().getChildFile(args.getValueForOption("--state"));
+
+    if( args.containsOption("--params") )
+        settings.parameterFile = juce::File::getCurrentWorkingDirectory().getChildFile(args.getValueForOption("--params"));
+
+    if( args.containsOption("--block") )
+        settings.blockSize = juce::jmax(1, args.getValueForOption("--block").getIntValue());
+
+    if( args.containsOption("--bits") )
+        settings.bitsPerSample = args.getValueForOption("--bits").getIntValue();
+
+    if( args.containsOption("--threads") )
+    {
+        auto threads = args.getValueForOption("--threads");
+        settings.numThreads = threads == "all" ? juce::SystemStats::getNumCpus()
+                                               : juce::jmax(1, threads.getIntValue());
+    }
+
+    if( args.containsOption("--segment") )
+        settings.segmentSeconds = juce::jmax(1.0, args.getValueForOption("--segment").getDoubleValue());
+
+    if( args.containsOption("--preroll") )
+        settings.prerollSeconds = juce::jmax(0.0, args.getValueForOption("--preroll").getDoubleValue());
+
+    if( args.containsOption("--verify") )
+    {
+        settings.verifyAgainstSerial = true;
+        auto tolerance = args.getValueForOption("--verify");
+        if( tolerance.isNotEmpty() )
+            settings.verifyToleranceDb = tolerance.getFloatValue();
+    }
+
+    OfflineRenderer renderer;
+    OfflineRenderer::Report report;
+    juce::String error;
+
+    if( ! renderer.render(settings, report, error) )
+    {
+        std::cerr << "error: " << error << std::endl;
+        return 1;
+    }
+
+    std::cout << settings.inputFile.getFileName() << " -> " << settings.outputFile.getFileName() << std::endl
+              << report.toString();
+
+    return 0;
+}
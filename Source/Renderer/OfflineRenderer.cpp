@@ -0,0 +1,593 @@
+/*
+  ==============================================================================
+
+    OfflineRenderer.cpp
+    Created: 19 Oct 2026 9:14:02am
+    Author:  Marc Woodbury-Smith
+
+  ==============================================================================
+*/
+
+#include "OfflineRenderer.h"
+
+namespace
+{
+double ticksToSeconds(juce::int64 ticks)
+{
+    return juce::Time::highResolutionTicksToSeconds(ticks);
+}
+}
+
+//==============================================================================
+bool StreamingAudioReader::open(juce::AudioFormatManager& formatManager, const juce::File& file)
+{
+    mappedReader.reset();
+    reader.reset();
+    mappedRange = {};
+
+    if( auto* format = formatManager.findFormatForFileExtension(file.getFileExtension()) )
+    {
+        mappedReader.reset(format->createMemoryMappedReader(file));
+    }
+
+    if( mappedReader == nullptr )
+    {
+        /*
+         not every format can be memory-mapped (FLAC can't), so fall back to a buffered stream.
+         */
+        reader.reset(formatManager.createReaderFor(file));
+    }
+
+    return get() != nullptr;
+}
+
+bool StreamingAudioReader::read(juce::AudioBuffer<float>& buffer, juce::int64 startSample, int numSamples)
+{
+    jassert(numSamples <= buffer.getNumSamples());
+
+    if( mappedReader != nullptr )
+    {
+        auto wanted = juce::Range<juce::int64>(startSample, startSample + numSamples);
+
+        if( ! mappedRange.contains(wanted) )
+        {
+            auto end = juce::jmin(startSample + juce::jmax(MapWindowSamples, (juce::int64)numSamples),
+                                  mappedReader->lengthInSamples);
+
+            if( ! mappedReader->mapSectionOfFile({ startSample, end }) )
+                return false;
+
+            mappedRange = mappedReader->getMappedSection();
+        }
+    }
+
+    return get()->read(&buffer,
+                       0,
+                       numSamples,
+                       startSample,
+                       true,
+                       true);
+}
+
+//==============================================================================
+OfflineRenderer::OfflineRenderer()
+{
+    formatManager.registerBasicFormats();
+}
+
+bool OfflineRenderer::applySettingsToProcessor(SimpleMBCompAudioProcessor& processor,
+                                               const Settings& settings,
+                                               juce::String& error)
+{
+    if( settings.stateFile != juce::File() )
+    {
+        juce::MemoryBlock state;
+        if( ! settings.stateFile.loadFileAsData(state) )
+        {
+            error = "Couldn't read state file " + settings.stateFile.getFullPathName();
+            return false;
+        }
+
+        processor.setStateInformation(state.getData(), static_cast<int>(state.getSize()));
+    }
+
+    if( settings.parameterFile != juce::File() )
+    {
+        juce::StringArray lines;
+        settings.parameterFile.readLines(lines);
+
+        for( auto line : lines )
+        {
+            line = line.upToFirstOccurrenceOf("#", false, false).trim();
+            if( line.isEmpty() )
+                continue;
+
+            auto name = line.upToFirstOccurrenceOf("=", false, false).trim();
+            auto value = line.fromFirstOccurrenceOf("=", false, false).trim();
+
+            auto* param = processor.apvts.getParameter(name);
+            if( param == nullptr || value.isEmpty() )
+            {
+                error = "Unknown parameter or missing value: '" + line + "'";
+                return false;
+            }
+
+            param->setValueNotifyingHost(param->getValueForText(value));
+        }
+    }
+
+    return true;
+}
+
+bool OfflineRenderer::prepareProcessor(SimpleMBCompAudioProcessor& processor,
+                                       int numChannels,
+                                       double sampleRate,
+                                       int blockSize)
+{
+    auto channelSet = numChannels == 1 ? juce::AudioChannelSet::mono() : juce::AudioChannelSet::stereo();
+
+    juce::AudioProcessor::BusesLayout layout;
+    layout.inputBuses.add(channelSet);
+    layout.outputBuses.add(channelSet);
+
+    if( numChannels > 2 || ! processor.setBusesLayout(layout) )
+        return false;
+
+    processor.setNonRealtime(true);
+    processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+    processor.prepareToPlay(sampleRate, blockSize);
+    return true;
+}
+
+std::unique_ptr<juce::AudioFormatWriter> OfflineRenderer::createWriterFor(const juce::File& file,
+                                                                          double sampleRate,
+                                                                          int numChannels,
+                                                                          int bitsPerSample,
+                                                                          juce::String& error)
+{
+    auto* format = formatManager.findFormatForFileExtension(file.getFileExtension());
+    if( format == nullptr )
+    {
+        error = "Unsupported output format: " + file.getFileName();
+        return {};
+    }
+
+    file.deleteFile();
+    auto stream = std::unique_ptr<juce::OutputStream>(file.createOutputStream());
+    if( stream == nullptr )
+    {
+        error = "Couldn't open " + file.getFullPathName() + " for writing";
+        return {};
+    }
+
+    std::unique_ptr<juce::AudioFormatWriter> writer(format->createWriterFor(stream.get(),
+                                                                            sampleRate,
+                                                                            static_cast<unsigned int>(numChannels),
+                                                                            bitsPerSample,
+                                                                            {},
+                                                                            0));
+    if( writer == nullptr )
+    {
+        error = "Couldn't create a " + format->getFormatName() + " writer with "
+              + juce::String(bitsPerSample) + " bits";
+        return {};
+    }
+
+    //the writer owns the stream now.
+    stream.release();
+    return writer;
+}
+
+bool OfflineRenderer::render(const Settings& settings, Report& report, juce::String& error)
+{
+    report.numThreads = juce::jmax(1, settings.numThreads);
+
+    auto ok = report.numThreads > 1 ? renderParallel(settings, report, error)
+                                    : renderSerial(settings, report, error);
+    if( ! ok || ! settings.verifyAgainstSerial || report.numThreads == 1 )
+        return ok;
+
+    /*
+     render the reference next to the output, in the same format, so both go
+     through identical quantisation.
+     */
+    auto reference = settings.outputFile.getSiblingFile(settings.outputFile.getFileNameWithoutExtension()
+                                                        + "-serial"
+                                                        + settings.outputFile.getFileExtension());
+    auto referenceSettings = settings;
+    referenceSettings.outputFile = reference;
+
+    Report referenceReport;
+    ok = renderSerial(referenceSettings, referenceReport, error)
+      && compareFiles(settings.outputFile, reference, report.maxDifferenceDb, error);
+
+    reference.deleteFile();
+
+    if( ! ok )
+        return false;
+
+    report.verified = report.maxDifferenceDb <= settings.verifyToleranceDb;
+    if( ! report.verified )
+    {
+        error = "Parallel render differs from the serial render by "
+              + juce::String(report.maxDifferenceDb, 1) + " dB (tolerance "
+              + juce::String(settings.verifyToleranceDb, 1) + " dB)";
+        return false;
+    }
+
+    return true;
+}
+
+bool OfflineRenderer::renderSerial(const Settings& settings, Report& report, juce::String& error)
+{
+    auto startTicks = juce::Time::getHighResolutionTicks();
+
+    StreamingAudioReader input;
+    if( ! input.open(formatManager, settings.inputFile) )
+    {
+        error = "Couldn't open " + settings.inputFile.getFullPathName();
+        return false;
+    }
+
+    report.numChannels = input.getNumChannels();
+    report.sampleRate = input.getSampleRate();
+    report.numSamples = input.getLengthInSamples();
+
+    auto processor = std::make_unique<SimpleMBCompAudioProcessor>();
+
+    if( ! applySettingsToProcessor(*processor, settings, error) )
+        return false;
+
+    if( ! prepareProcessor(*processor, report.numChannels, report.sampleRate, settings.blockSize) )
+    {
+        error = "Unsupported channel count: " + juce::String(report.numChannels);
+        return false;
+    }
+
+    auto writer = createWriterFor(settings.outputFile,
+                                  report.sampleRate,
+                                  report.numChannels,
+                                  settings.bitsPerSample,
+                                  error);
+    if( writer == nullptr )
+        return false;
+
+    juce::AudioBuffer<float> buffer(report.numChannels, settings.blockSize);
+    juce::MidiBuffer midi;
+
+    juce::int64 readTicks = 0, processTicks = 0, writeTicks = 0;
+
+    for( juce::int64 pos = 0; pos < report.numSamples; pos += settings.blockSize )
+    {
+        auto numSamples = static_cast<int>(juce::jmin((juce::int64)settings.blockSize, report.numSamples - pos));
+
+        /*
+         the processor never sees a block larger than the one it was prepared with,
+         but the last one can be shorter.
+         */
+        buffer.setSize(report.numChannels, numSamples, false, false, true);
+
+        auto t0 = juce::Time::getHighResolutionTicks();
+        if( ! input.read(buffer, pos, numSamples) )
+        {
+            error = "Read failed at sample " + juce::String(pos);
+            return false;
+        }
+
+        auto t1 = juce::Time::getHighResolutionTicks();
+        processor->processBlock(buffer, midi);
+
+        auto t2 = juce::Time::getHighResolutionTicks();
+        if( ! writer->writeFromAudioSampleBuffer(buffer, 0, numSamples) )
+        {
+            error = "Write failed at sample " + juce::String(pos);
+            return false;
+        }
+
+        auto t3 = juce::Time::getHighResolutionTicks();
+
+        readTicks += t1 - t0;
+        processTicks += t2 - t1;
+        writeTicks += t3 - t2;
+    }
+
+    report.profile = processor->profiler.getSnapshot();
+    report.deadline = processor->deadlineMonitor.getSnapshot();
+    processor->releaseResources();
+
+    auto flushStart = juce::Time::getHighResolutionTicks();
+    writer.reset();
+    writeTicks += juce::Time::getHighResolutionTicks() - flushStart;
+
+    report.readSeconds = ticksToSeconds(readTicks);
+    report.processSeconds = ticksToSeconds(processTicks);
+    report.writeSeconds = ticksToSeconds(writeTicks);
+    report.totalSeconds = ticksToSeconds(juce::Time::getHighResolutionTicks() - startTicks);
+
+    return true;
+}
+
+//==============================================================================
+struct OfflineRenderer::Segment
+{
+    juce::int64 start = 0;
+    int length = 0;
+
+    juce::AudioBuffer<float> output;
+    double processSeconds = 0.0;
+    double readSeconds = 0.0;
+    StageProfiler::Snapshot profile;
+    DeadlineMonitor::Snapshot deadline;
+
+    bool ok = false;
+    juce::String error;
+    std::atomic<bool> finished { false };
+};
+
+bool OfflineRenderer::renderSegment(const Settings& settings, Segment& segment, juce::String& error)
+{
+    /*
+     every segment gets its own reader and its own processor, so nothing is shared between threads.
+     */
+    StreamingAudioReader input;
+    if( ! input.open(formatManager, settings.inputFile) )
+    {
+        error = "Couldn't open " + settings.inputFile.getFullPathName();
+        return false;
+    }
+
+    auto numChannels = input.getNumChannels();
+    auto sampleRate = input.getSampleRate();
+
+    auto processor = std::make_unique<SimpleMBCompAudioProcessor>();
+
+    if( ! applySettingsToProcessor(*processor, settings, error) )
+        return false;
+
+    if( ! prepareProcessor(*processor, numChannels, sampleRate, settings.blockSize) )
+    {
+        error = "Unsupported channel count: " + juce::String(numChannels);
+        return false;
+    }
+
+    /*
+     a whole number of blocks, so the pre-roll doesn't shift the block grid:
+     segment.start is block aligned, and so is every block after it.
+     */
+    auto blockSize = (juce::int64)settings.blockSize;
+    auto prerollBlocks = (static_cast<juce::int64>(std::ceil(settings.prerollSeconds * sampleRate)) + blockSize - 1) / blockSize;
+    auto preroll = juce::jmin(segment.start, prerollBlocks * blockSize);
+
+    segment.output.setSize(numChannels, segment.length);
+
+    juce::AudioBuffer<float> buffer(numChannels, settings.blockSize);
+    juce::MidiBuffer midi;
+
+    auto end = segment.start + segment.length;
+    juce::int64 readTicks = 0, processTicks = 0;
+
+    for( auto pos = segment.start - preroll; pos < end; pos += settings.blockSize )
+    {
+        auto numSamples = static_cast<int>(juce::jmin((juce::int64)settings.blockSize, end - pos));
+        buffer.setSize(numChannels, numSamples, false, false, true);
+
+        auto t0 = juce::Time::getHighResolutionTicks();
+        if( ! input.read(buffer, pos, numSamples) )
+        {
+            error = "Read failed at sample " + juce::String(pos);
+            return false;
+        }
+
+        auto t1 = juce::Time::getHighResolutionTicks();
+        processor->processBlock(buffer, midi);
+        processTicks += juce::Time::getHighResolutionTicks() - t1;
+        readTicks += t1 - t0;
+
+        /*
+         only keep what falls inside this segment; the pre-roll is thrown away.
+         */
+        auto skip = static_cast<int>(juce::jlimit(juce::int64(0), (juce::int64)numSamples, segment.start - pos));
+        auto destStart = static_cast<int>(pos + skip - segment.start);
+
+        for( int ch = 0; ch < numChannels; ++ch )
+        {
+            if( numSamples > skip )
+                segment.output.copyFrom(ch, destStart, buffer, ch, skip, numSamples - skip);
+        }
+    }
+
+    segment.profile = processor->profiler.getSnapshot();
+    segment.deadline = processor->deadlineMonitor.getSnapshot();
+    processor->releaseResources();
+
+    segment.readSeconds = ticksToSeconds(readTicks);
+    segment.processSeconds = ticksToSeconds(processTicks);
+    return true;
+}
+
+bool OfflineRenderer::renderParallel(const Settings& settings, Report& report, juce::String& error)
+{
+    auto startTicks = juce::Time::getHighResolutionTicks();
+
+    StreamingAudioReader input;
+    if( ! input.open(formatManager, settings.inputFile) )
+    {
+        error = "Couldn't open " + settings.inputFile.getFullPathName();
+        return false;
+    }
+
+    report.numChannels = input.getNumChannels();
+    report.sampleRate = input.getSampleRate();
+    report.numSamples = input.getLengthInSamples();
+
+    /*
+     segments are a whole number of blocks long, so every instance sees the same block boundaries
+     a serial render would.
+     */
+    auto blocksPerSegment = juce::jmax(juce::int64(1),
+                                       (juce::int64)(settings.segmentSeconds * report.sampleRate) / settings.blockSize);
+    auto segmentLength = blocksPerSegment * settings.blockSize;
+
+    std::vector<std::unique_ptr<Segment>> segments;
+    for( juce::int64 start = 0; start < report.numSamples; start += segmentLength )
+    {
+        auto segment = std::make_unique<Segment>();
+        segment->start = start;
+        segment->length = static_cast<int>(juce::jmin(segmentLength, report.numSamples - start));
+        segments.push_back(std::move(segment));
+    }
+
+    report.numSegments = static_cast<int>(segments.size());
+
+    auto writer = createWriterFor(settings.outputFile,
+                                  report.sampleRate,
+                                  report.numChannels,
+                                  settings.bitsPerSample,
+                                  error);
+    if( writer == nullptr )
+        return false;
+
+    juce::ThreadPool pool(report.numThreads);
+    juce::WaitableEvent segmentFinished;
+
+    /*
+     finished segments are held in memory until all earlier ones have been written,
+     so cap how many can be outstanding at once.
+     */
+    const auto maxSegmentsInFlight = static_cast<size_t>(report.numThreads * 2);
+
+    size_t nextToSubmit = 0;
+    juce::int64 writeTicks = 0;
+    auto ok = true;
+
+    for( size_t nextToWrite = 0; nextToWrite < segments.size() && ok; ++nextToWrite )
+    {
+        while( nextToSubmit < segments.size() && nextToSubmit - nextToWrite < maxSegmentsInFlight )
+        {
+            auto* segment = segments[nextToSubmit++].get();
+            pool.addJob([this, &settings, segment, &segmentFinished]()
+            {
+                segment->ok = renderSegment(settings, *segment, segment->error);
+                segment->finished.store(true);
+                segmentFinished.signal();
+            });
+        }
+
+        auto& segment = *segments[nextToWrite];
+        while( ! segment.finished.load() )
+            segmentFinished.wait(100);
+
+        if( ! segment.ok )
+        {
+            error = segment.error;
+            ok = false;
+            break;
+        }
+
+        auto t0 = juce::Time::getHighResolutionTicks();
+        if( ! writer->writeFromAudioSampleBuffer(segment.output, 0, segment.length) )
+        {
+            error = "Write failed at sample " + juce::String(segment.start);
+            ok = false;
+        }
+        writeTicks += juce::Time::getHighResolutionTicks() - t0;
+
+        report.readSeconds += segment.readSeconds;
+        report.processSeconds += segment.processSeconds;
+        report.profile += segment.profile;
+        report.deadline += segment.deadline;
+        segment.output.setSize(0, 0);
+    }
+
+    pool.removeAllJobs(true, -1);
+
+    auto flushStart = juce::Time::getHighResolutionTicks();
+    writer.reset();
+    writeTicks += juce::Time::getHighResolutionTicks() - flushStart;
+
+    report.writeSeconds = ticksToSeconds(writeTicks);
+    report.totalSeconds = ticksToSeconds(juce::Time::getHighResolutionTicks() - startTicks);
+
+    return ok;
+}
+
+bool OfflineRenderer::compareFiles(const juce::File& a, const juce::File& b, float& maxDifferenceDb, juce::String& error)
+{
+    StreamingAudioReader readerA, readerB;
+    if( ! readerA.open(formatManager, a) || ! readerB.open(formatManager, b) )
+    {
+        error = "Couldn't open files for comparison";
+        return false;
+    }
+
+    if( readerA.getNumChannels() != readerB.getNumChannels()
+     || readerA.getLengthInSamples() != readerB.getLengthInSamples() )
+    {
+        error = "Rendered files differ in length or channel count";
+        return false;
+    }
+
+    const int chunk = 1 << 16;
+    auto numChannels = readerA.getNumChannels();
+    juce::AudioBuffer<float> bufferA(numChannels, chunk), bufferB(numChannels, chunk);
+
+    auto maxDifference = 0.f;
+    auto length = readerA.getLengthInSamples();
+
+    for( juce::int64 pos = 0; pos < length; pos += chunk )
+    {
+        auto numSamples = static_cast<int>(juce::jmin((juce::int64)chunk, length - pos));
+        if( ! readerA.read(bufferA, pos, numSamples) || ! readerB.read(bufferB, pos, numSamples) )
+        {
+            error = "Read failed while comparing at sample " + juce::String(pos);
+            return false;
+        }
+
+        for( int ch = 0; ch < numChannels; ++ch )
+        {
+            auto* x = bufferA.getReadPointer(ch);
+            auto* y = bufferB.getReadPointer(ch);
+            for( int i = 0; i < numSamples; ++i )
+                maxDifference = juce::jmax(maxDifference, std::abs(x[i] - y[i]));
+        }
+    }
+
+    maxDifferenceDb = juce::Decibels::gainToDecibels(maxDifference, NEGATIVE_INFINITY * 2.f);
+    return true;
+}
+
+juce::String OfflineRenderer::Report::toString() const
+{
+    auto percent = [total = totalSeconds](double seconds)
+    {
+        return juce::String(total > 0.0 ? 100.0 * seconds / total : 0.0, 1) + "%";
+    };
+
+    juce::String str;
+    str << "audio:    " << juce::String(getAudioSeconds(), 2) << " s, "
+        << numChannels << " ch @ " << sampleRate << " Hz" << juce::newLine;
+    str << "wall:     " << juce::String(totalSeconds, 3) << " s ("
+        << juce::String(getRealtimeFactor(), 1) << "x realtime)" << juce::newLine;
+    str << "read:     " << juce::String(readSeconds, 3) << " s (" << percent(readSeconds) << ")" << juce::newLine;
+    str << "process:  " << juce::String(processSeconds, 3) << " s (" << percent(processSeconds) << ")" << juce::newLine;
+    str << "write:    " << juce::String(writeSeconds, 3) << " s (" << percent(writeSeconds) << ")" << juce::newLine;
+
+    if( numThreads > 1 )
+    {
+        /*
+         read and process times are summed over all worker threads.
+         */
+        str << "threads:  " << numThreads << ", " << numSegments << " segments" << juce::newLine;
+
+        if( verified )
+            str << "verified: max difference from serial render " << juce::String(maxDifferenceDb, 1) << " dB" << juce::newLine;
+    }
+
+    /*
+     offline blocks run faster than real time, so this shows how much headroom
+     the same settings would have live.
+     */
+    str << juce::newLine << "deadline" << juce::newLine << deadline.toString();
+    str << juce::newLine << profile.toString();
+    return str;
+}
@@ -0,0 +1,141 @@
+/*
+  ==============================================================================
+
+    OfflineRenderer.h
+    Created: 19 Oct 2026 9:14:02am
+    Author:  Marc Woodbury-Smith
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "../PluginProcessor.h"
+
+/*
+ Streams an audio file through a SimpleMBCompAudioProcessor without a host.
+ The input is read chunk by chunk (memory-mapped where the format allows it),
+ so files of any length can be processed with a fixed amount of memory.
+ */
+struct OfflineRenderer
+{
+    struct Settings
+    {
+        juce::File inputFile, outputFile;
+        juce::File stateFile;       //binary blob produced by getStateInformation()
+        juce::File parameterFile;   //"Parameter Name = value" lines
+        int blockSize = 512;
+        int bitsPerSample = 24;
+
+        /*
+         with more than one thread the file is split into segments that are rendered
+         by independent processor instances. Each instance first processes
+         'prerollSeconds' of the audio before its segment and discards the result,
+         so the crossover and compressor envelopes have converged when its output starts.
+         */
+        int numThreads = 1;
+        double segmentSeconds = 60.0;
+        double prerollSeconds = 2.0;
+
+        /*
+         renders serially as well and compares the two outputs sample by sample.
+         */
+        bool verifyAgainstSerial = false;
+        float verifyToleranceDb = -80.f;
+    };
+
+    struct Report
+    {
+        juce::int64 numSamples = 0;
+        int numChannels = 0;
+        double sampleRate = 0.0;
+
+        double readSeconds = 0.0;
+        double processSeconds = 0.0;
+        double writeSeconds = 0.0;
+        double totalSeconds = 0.0;
+
+        int numThreads = 1;
+        int numSegments = 1;
+
+        bool verified = false;
+        float maxDifferenceDb = NEGATIVE_INFINITY;
+
+        /*
+         per-stage processBlock() timings, summed over every processor instance used.
+         */
+        StageProfiler::Snapshot profile;
+        DeadlineMonitor::Snapshot deadline;
+
+        double getAudioSeconds() const { return sampleRate > 0.0 ? numSamples / sampleRate : 0.0; }
+        double getRealtimeFactor() const { return totalSeconds > 0.0 ? getAudioSeconds() / totalSeconds : 0.0; }
+
+        juce::String toString() const;
+    };
+
+    OfflineRenderer();
+
+    /*
+     returns false and fills in 'error' if anything goes wrong.
+     */
+    bool render(const Settings& settings, Report& report, juce::String& error);
+
+    /*
+     streams both files and returns the largest absolute sample difference in dB.
+     */
+    bool compareFiles(const juce::File& a, const juce::File& b, float& maxDifferenceDb, juce::String& error);
+
+    static bool applySettingsToProcessor(SimpleMBCompAudioProcessor& processor,
+                                         const Settings& settings,
+                                         juce::String& error);
+
+    static bool prepareProcessor(SimpleMBCompAudioProcessor& processor,
+                                 int numChannels,
+                                 double sampleRate,
+                                 int blockSize);
+
+    juce::AudioFormatManager& getFormatManager() { return formatManager; }
+
+    std::unique_ptr<juce::AudioFormatWriter> createWriterFor(const juce::File& file,
+                                                             double sampleRate,
+                                                             int numChannels,
+                                                             int bitsPerSample,
+                                                             juce::String& error);
+private:
+    juce::AudioFormatManager formatManager;
+
+    bool renderSerial(const Settings& settings, Report& report, juce::String& error);
+    bool renderParallel(const Settings& settings, Report& report, juce::String& error);
+
+    struct Segment;
+    bool renderSegment(const Settings& settings, Segment& segment, juce::String& error);
+};
+
+//==============================================================================
+/*
+ Wraps either a MemoryMappedAudioFormatReader or a regular streaming reader.
+ When memory-mapped, only a sliding window of the file is mapped at a time.
+ */
+struct StreamingAudioReader
+{
+    bool open(juce::AudioFormatManager& formatManager, const juce::File& file);
+
+    bool read(juce::AudioBuffer<float>& buffer, juce::int64 startSample, int numSamples);
+
+    juce::AudioFormatReader* get() const
+    {
+        return mappedReader != nullptr ? static_cast<juce::AudioFormatReader*>(mappedReader.get()) : reader.get();
+    }
+
+    bool isMemoryMapped() const { return mappedReader != nullptr; }
+
+    juce::int64 getLengthInSamples() const { return get() != nullptr ? get()->lengthInSamples : 0; }
+    int getNumChannels() const { return get() != nullptr ? static_cast<int>(get()->numChannels) : 0; }
+    double getSampleRate() const { return get() != nullptr ? get()->sampleRate : 0.0; }
+private:
+    static constexpr juce::int64 MapWindowSamples = 1 << 22;
+
+    std::unique_ptr<juce::MemoryMappedAudioFormatReader> mappedReader;
+    std::unique_ptr<juce::AudioFormatReader> reader;
+    juce::Range<juce::int64> mappedRange;
+};